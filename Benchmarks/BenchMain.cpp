@@ -0,0 +1,112 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// BenchMain.cpp - simdsynth-bench: runs the DSP benchmarks over a parameter grid and writes the results as
+// JSON (to stdout unless --out is given; progress goes to stderr).
+
+#include "Benchmark.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static void printUsage() {
+    std::printf("usage: simdsynth-bench [--filter <text>] [--voices 1,4,...,128] [--unison 1,2,4,8]\n"
+                "                       [--waveform 0,1,2] [--bypass 0,1] [--block 64,512] [--min-time <ms>]\n"
+                "                       [--repetitions <n>]\n"
+                "                       [--quick] [--list] [--out <file.json>]\n");
+}
+
+// "1,4,16" -> {1, 4, 16}
+static std::vector<int> parseList(const char *text) {
+    std::vector<int> values;
+    for (const char *p = text; *p != '\0';) {
+        char *end = nullptr;
+        const long value = std::strtol(p, &end, 10);
+        if (end == p) break;
+        values.push_back(static_cast<int>(value));
+        p = (*end == ',') ? end + 1 : end;
+    }
+    return values;
+}
+
+int main(int argc, char *argv[]) {
+    BenchOptions options;
+    const char *outPath = nullptr;
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        auto takesValue = [&](const char *name) {
+            if (std::strcmp(arg, name) != 0) return false;
+            if (value == nullptr) {
+                std::fprintf(stderr, "simdsynth-bench: %s needs a value\n", name);
+                std::exit(1);
+            }
+            ++i;
+            return true;
+        };
+
+        if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+            printUsage();
+            return 0;
+        } else if (std::strcmp(arg, "--list") == 0) {
+            list = true;
+        } else if (std::strcmp(arg, "--quick") == 0) {
+            // A short run for a quick comparison between builds
+            options.voices = {1, 16, 128};
+            options.unison = {1, 4};
+            options.waveforms = {1};
+            options.blocks = {512};
+            options.minTimeMs = 5.0;
+            options.repetitions = 3;
+        } else if (takesValue("--filter")) {
+            options.filter = value;
+        } else if (takesValue("--voices")) {
+            options.voices = parseList(value);
+        } else if (takesValue("--unison")) {
+            options.unison = parseList(value);
+        } else if (takesValue("--waveform")) {
+            options.waveforms = parseList(value);
+        } else if (takesValue("--bypass")) {
+            options.bypass = parseList(value);
+        } else if (takesValue("--block")) {
+            options.blocks = parseList(value);
+        } else if (takesValue("--min-time")) {
+            options.minTimeMs = std::atof(value);
+        } else if (takesValue("--repetitions")) {
+            options.repetitions = std::atoi(value);
+        } else if (takesValue("--out")) {
+            outPath = value;
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    BenchmarkSuite suite;
+    registerKernelBenchmarks(suite);
+    registerProcessorBenchmarks(suite);
+
+    if (list) {
+        for (const Benchmark &benchmark : suite.getBenchmarks()) std::printf("%s\n", benchmark.name.c_str());
+        return 0;
+    }
+
+    const std::vector<BenchResult> results = suite.run(options);
+
+    std::FILE *out = outPath != nullptr ? std::fopen(outPath, "w") : stdout;
+    if (out == nullptr) {
+        std::fprintf(stderr, "simdsynth-bench: cannot write %s\n", outPath);
+        return 1;
+    }
+    BenchmarkSuite::writeJson(out, results);
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
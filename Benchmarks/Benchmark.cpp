@@ -0,0 +1,126 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// Benchmark.cpp - Parameter grid expansion, timing and JSON output for simdsynth-bench.
+
+#include "Benchmark.h"
+#include "VoiceKernels.h"
+
+#include <algorithm>
+#include <chrono>
+
+// Values of one axis: the requested ones if the benchmark varies it, otherwise just the default
+static std::vector<int> axisValues(unsigned axes, BenchAxis axis, const std::vector<int> &requested, int fallback) {
+    if ((axes & axis) == 0 || requested.empty()) return {fallback};
+    return requested;
+}
+
+static double timeCalls(const std::function<void()> &body, long long calls) {
+    const auto start = std::chrono::steady_clock::now();
+    for (long long i = 0; i < calls; ++i) body();
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+// Time one prepared benchmark: calibrate the call count to the minimum repetition time, then take the
+// median and the fastest of the repetitions
+static BenchResult measure(const Benchmark &benchmark, const BenchConfig &config, const BenchOptions &options) {
+    BenchInstance instance = benchmark.setup(config);
+    const double minTimeNs = options.minTimeMs * 1.0e6;
+
+    long long calls = 1;
+    double elapsed = timeCalls(instance.body, calls); // Also warms caches and branch predictors
+    while (elapsed < minTimeNs) {
+        const double scale = elapsed > 0.0 ? 1.2 * minTimeNs / elapsed : 10.0;
+        calls = std::max(calls * 2, static_cast<long long>(static_cast<double>(calls) * std::min(scale, 100.0)));
+        elapsed = timeCalls(instance.body, calls);
+    }
+
+    std::vector<double> perCall;
+    for (int r = 0; r < std::max(1, options.repetitions); ++r) {
+        perCall.push_back(timeCalls(instance.body, calls) / static_cast<double>(calls));
+    }
+    std::sort(perCall.begin(), perCall.end());
+
+    BenchResult result;
+    result.name = benchmark.name;
+    result.axes = benchmark.axes;
+    result.config = config;
+    result.isa = instance.isa;
+    result.oversampling = instance.oversampling;
+    result.iterations = calls;
+    result.nsPerCall = perCall[perCall.size() / 2];
+    result.nsPerCallMin = perCall.front();
+    result.nsPerSampleVoice = result.nsPerCall / (instance.samplesPerCall * std::max(1, instance.voicesPerCall));
+    if (instance.report) instance.report(result);
+    return result;
+}
+
+std::vector<BenchResult> BenchmarkSuite::run(const BenchOptions &options) const {
+    const BenchConfig defaults;
+    std::vector<int> voices;
+    for (int v : options.voices) {
+        if (v >= 1 && v <= MAX_VOICE_POLYPHONY) voices.push_back(v);
+    }
+    std::vector<int> unison;
+    for (int u : options.unison) {
+        if (u >= 1 && u <= maxUnison) unison.push_back(u);
+    }
+
+    std::vector<BenchResult> results;
+    for (const Benchmark &benchmark : benchmarks) {
+        if (benchmark.name.find(options.filter) == std::string::npos) continue;
+        const unsigned axes = benchmark.axes;
+        for (int v : axisValues(axes, AxisVoices, voices, std::min(defaults.voices, MAX_VOICE_POLYPHONY)))
+            for (int u : axisValues(axes, AxisUnison, unison, defaults.unison))
+                for (int w : axisValues(axes, AxisWaveform, options.waveforms, defaults.waveform))
+                    for (int b : axisValues(axes, AxisBypass, options.bypass, defaults.bypass ? 1 : 0))
+                        for (int block : axisValues(axes, AxisBlock, options.blocks, defaults.block)) {
+                            const BenchConfig config{v, u, w, b != 0, block};
+                            results.push_back(measure(benchmark, config, options));
+                            const BenchResult &r = results.back();
+                            std::fprintf(stderr,
+                                         "%-38s %-6s voices %2d unison %d wave %d bypass %d block %4d"
+                                         "  %10.1f ns  %7.3f ns/sample/voice\n",
+                                         r.name.c_str(), r.isa.c_str(), v, u, w, b, block, r.nsPerCall,
+                                         r.nsPerSampleVoice);
+                        }
+    }
+    return results;
+}
+
+void BenchmarkSuite::writeJson(std::FILE *out, const std::vector<BenchResult> &results) {
+    const KernelTable &kernels = selectKernels();
+    std::fprintf(out, "{\n  \"suite\": \"simdsynth-bench\",\n  \"format\": 1,\n");
+    std::fprintf(out, "  \"kernels\": \"%s\",\n  \"width\": %d,\n", kernels.name, kernels.width);
+    std::fprintf(out, "  \"max_voices\": %d,\n  \"max_unison\": %d,\n  \"control_period\": %d,\n", MAX_VOICE_POLYPHONY,
+                 maxUnison, RENDER_SUB_BLOCK);
+    std::fprintf(out, "  \"results\": [");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult &r = results[i];
+        std::fprintf(out, "%s\n    {\"name\": \"%s\", \"isa\": \"%s\"", i == 0 ? "" : ",", r.name.c_str(),
+                     r.isa.c_str());
+        if (r.axes & AxisVoices) std::fprintf(out, ", \"voices\": %d", r.config.voices);
+        if (r.axes & AxisUnison) std::fprintf(out, ", \"unison\": %d", r.config.unison);
+        if (r.axes & AxisWaveform) std::fprintf(out, ", \"waveform\": %d", r.config.waveform);
+        if (r.axes & AxisBypass) std::fprintf(out, ", \"bypass\": %s", r.config.bypass ? "true" : "false");
+        if (r.axes & AxisBlock) std::fprintf(out, ", \"block\": %d", r.config.block);
+        std::fprintf(out, ", \"oversampling\": %d, \"iterations\": %lld", r.oversampling, r.iterations);
+        std::fprintf(out, ", \"ns_per_call\": %.2f, \"ns_per_call_min\": %.2f, \"ns_per_sample_voice\": %.4f",
+                     r.nsPerCall, r.nsPerCallMin, r.nsPerSampleVoice);
+        if (!r.stages.empty()) {
+            std::fprintf(out, ", \"stages_ns\": {");
+            for (size_t s = 0; s < r.stages.size(); ++s) {
+                std::fprintf(out, "%s\"%s\": %.2f", s == 0 ? "" : ", ", r.stages[s].first.c_str(), r.stages[s].second);
+            }
+            std::fprintf(out, "}");
+        }
+        std::fprintf(out, "}");
+    }
+    std::fprintf(out, "\n  ]\n}\n");
+}
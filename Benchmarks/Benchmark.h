@@ -0,0 +1,97 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// Benchmark.h - A small benchmark harness for simdsynth-bench. Each benchmark names the parameters it
+// varies; the suite runs it over every combination of the requested values and reports the time per call
+// and per sample and voice, so results can be compared between versions.
+#pragma once
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Parameters a benchmark can be run over
+enum BenchAxis : unsigned {
+    AxisVoices = 1 << 0,   // Active voices
+    AxisUnison = 1 << 1,   // Unison voices per note
+    AxisWaveform = 1 << 2, // 0=sine, 1=saw, 2=square
+    AxisBypass = 1 << 3,   // Filter bypass
+    AxisBlock = 1 << 4     // Host block size in samples
+};
+
+// One point of the parameter grid
+struct BenchConfig {
+        int voices = 16;
+        int unison = 1;
+        int waveform = 1;
+        bool bypass = false;
+        int block = 512;
+};
+
+struct BenchResult;
+
+// A benchmark prepared for one configuration: the body to time and the work one call does
+struct BenchInstance {
+        std::function<void()> body;
+        double samplesPerCall = 1.0; // Samples per lane and call
+        int voicesPerCall = 1;       // Voices (or lanes) per call
+        std::string isa;             // Instruction set the body runs on
+        int oversampling = 1;        // Oversampling factor, for the processor benchmarks
+        std::function<void(BenchResult &)> report; // Adds the benchmark's own figures after timing, if set
+};
+
+struct Benchmark {
+        std::string name;
+        unsigned axes = 0; // BenchAxis bits
+        std::function<BenchInstance(const BenchConfig &)> setup;
+};
+
+struct BenchResult {
+        std::string name;
+        unsigned axes = 0;
+        BenchConfig config;
+        std::string isa;
+        int oversampling = 1;
+        long long iterations = 0; // Calls per timed repetition
+        double nsPerCall = 0.0;    // Median over the repetitions
+        double nsPerCallMin = 0.0; // Fastest repetition
+        double nsPerSampleVoice = 0.0;
+        std::vector<std::pair<std::string, double>> stages; // Stage name and ns per call, in profiling builds
+};
+
+struct BenchOptions {
+        std::string filter;              // Run only benchmarks whose name contains this
+        std::vector<int> voices{1, 4, 8, 16, 32, 64, 128};
+        std::vector<int> unison{1, 2, 4, 8};
+        std::vector<int> waveforms{0, 1, 2};
+        std::vector<int> bypass{0, 1};
+        std::vector<int> blocks{64, 512};
+        double minTimeMs = 20.0; // Minimum duration of one timed repetition
+        int repetitions = 5;
+};
+
+class BenchmarkSuite {
+    public:
+        void add(Benchmark benchmark) { benchmarks.push_back(std::move(benchmark)); }
+        const std::vector<Benchmark> &getBenchmarks() const { return benchmarks; }
+
+        // Run every matching benchmark over its parameter grid; progress goes to stderr
+        std::vector<BenchResult> run(const BenchOptions &options) const;
+
+        // Results as one JSON document
+        static void writeJson(std::FILE *out, const std::vector<BenchResult> &results);
+
+    private:
+        std::vector<Benchmark> benchmarks;
+};
+
+// Registered by the translation units in Benchmarks/
+void registerKernelBenchmarks(BenchmarkSuite &suite);
+void registerProcessorBenchmarks(BenchmarkSuite &suite);
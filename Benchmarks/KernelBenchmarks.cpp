@@ -0,0 +1,360 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// KernelBenchmarks.cpp - Benchmarks for the JUCE-independent engine: the kernel building blocks, the
+// dispatched kernel table and SynthEngine itself.
+//
+// The building blocks (lookup, sin_ps, ladder) are instantiated here for the scalar backend and the baseline
+// instruction set this file is compiled for. Everything that goes through the kernel table runs on the
+// instruction set picked at startup; set SIMDSYNTH_ISA to measure another one.
+
+#include "Benchmark.h"
+#include "SynthEngine.h"
+#include "VoiceKernelsImpl.h" // Baseline ISA only, same flags as the matching kernel translation unit
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+// Elements per call for the building-block benchmarks
+static constexpr int BENCH_ELEMENTS = 1024;
+
+static std::vector<float> makeSawTable() {
+    std::vector<float> table(WAVETABLE_SIZE);
+    for (int i = 0; i < WAVETABLE_SIZE; ++i) table[i] = 2.0f * static_cast<float>(i) / WAVETABLE_SIZE - 1.0f;
+    return table;
+}
+
+// Lanes with every voice gated on and mid-range oscillator and filter settings
+static void initLanes(VoiceLanes &lanes, int activeVoices) {
+    for (int v = 0; v < VOICE_BANK_SIZE; ++v) {
+        const float freq = 110.0f * (1.0f + 0.25f * static_cast<float>(v % 12));
+        lanes.phase[v] = 0.07f * static_cast<float>(v);
+        lanes.phaseIncrement[v] = freq / 48000.0f;
+        lanes.subPhaseIncrement[v] = simdmath::twoPi * 0.5f * freq / 48000.0f;
+        lanes.osc2PhaseIncrement[v] = simdmath::twoPi * freq / 48000.0f;
+        lanes.lfoPhase[v] = 0.3f * static_cast<float>(v);
+        lanes.ladderAlphaStart[v] = lanes.ladderAlphaEnd[v] = 0.4f;
+        lanes.ladderResonanceStart[v] = lanes.ladderResonanceEnd[v] = 2.0f;
+        lanes.gate[v] = v < activeVoices ? 1.0f : 0.0f;
+    }
+}
+
+// Wavetable lookup, one table per lane (formerly wavetable_lookup_ps)
+template <typename V>
+static Benchmark lookupBenchmark(const char *isa) {
+    struct State {
+            std::vector<float> table = makeSawTable();
+            const float *tables[MAX_SIMD_WIDTH];
+            alignas(64) float phases[BENCH_ELEMENTS];
+            alignas(64) float sink[MAX_SIMD_WIDTH];
+    };
+    return {"voicekernels::lookup", 0, [isa](const BenchConfig &) {
+                auto s = std::make_shared<State>();
+                std::fill(std::begin(s->tables), std::end(s->tables), s->table.data());
+                for (int i = 0; i < BENCH_ELEMENTS; ++i) s->phases[i] = static_cast<float>(i) * 0.618034f;
+                BenchInstance instance;
+                instance.body = [s] {
+                    V acc = V::set1(0.0f);
+                    for (int i = 0; i < BENCH_ELEMENTS; i += V::width) {
+                        acc = acc + voicekernels::lookup(V::load(s->phases + i), s->tables);
+                    }
+                    acc.store(s->sink);
+                };
+                instance.samplesPerCall = BENCH_ELEMENTS / V::width;
+                instance.voicesPerCall = V::width;
+                instance.isa = isa;
+                return instance;
+            }};
+}
+
+// Vector sine (formerly fast_sin_ps)
+template <typename V>
+static Benchmark sinBenchmark(const char *isa) {
+    struct State {
+            alignas(64) float phases[BENCH_ELEMENTS];
+            alignas(64) float sink[MAX_SIMD_WIDTH];
+    };
+    return {"simdmath::sin_ps", 0, [isa](const BenchConfig &) {
+                auto s = std::make_shared<State>();
+                for (int i = 0; i < BENCH_ELEMENTS; ++i) {
+                    s->phases[i] = simdmath::twoPi * static_cast<float>(i) / BENCH_ELEMENTS - simdmath::pi;
+                }
+                BenchInstance instance;
+                instance.body = [s] {
+                    V acc = V::set1(0.0f);
+                    for (int i = 0; i < BENCH_ELEMENTS; i += V::width) {
+                        acc = acc + simdmath::sin_ps(V::load(s->phases + i));
+                    }
+                    acc.store(s->sink);
+                };
+                instance.samplesPerCall = BENCH_ELEMENTS / V::width;
+                instance.voicesPerCall = V::width;
+                instance.isa = isa;
+                return instance;
+            }};
+}
+
+// Ladder filter over one control period for one batch of voices (formerly applyLadderFilter)
+template <typename V>
+static Benchmark ladderBenchmark(const char *isa) {
+    struct State {
+            VoiceLanes lanes;
+            alignas(64) float input[RENDER_SUB_BLOCK * MAX_SIMD_WIDTH];
+            alignas(64) float output[RENDER_SUB_BLOCK * MAX_SIMD_WIDTH];
+    };
+    return {"voicekernels::ladder", 0, [isa](const BenchConfig &) {
+                auto s = std::make_shared<State>();
+                initLanes(s->lanes, MAX_VOICE_POLYPHONY);
+                for (int i = 0; i < RENDER_SUB_BLOCK * MAX_SIMD_WIDTH; ++i) {
+                    s->input[i] = static_cast<float>(i % 37) / 18.0f - 1.0f;
+                }
+                BenchInstance instance;
+                instance.body = [s] { voicekernels::ladder<V>(s->lanes, 0, s->input, s->output, RENDER_SUB_BLOCK); };
+                instance.samplesPerCall = RENDER_SUB_BLOCK;
+                instance.voicesPerCall = V::width;
+                instance.isa = isa;
+                return instance;
+            }};
+}
+
+template <typename V>
+static void addBuildingBlocks(BenchmarkSuite &suite, const char *isa) {
+    suite.add(lookupBenchmark<V>(isa));
+    suite.add(sinBenchmark<V>(isa));
+    suite.add(ladderBenchmark<V>(isa));
+}
+
+// One envelope tick for the whole voice bank (the SIMD part of updateEnvelopes)
+static Benchmark tickEnvelopesBenchmark() {
+    struct State {
+            EnvelopeBank env;
+            alignas(64) float gate[VOICE_BANK_SIZE];
+    };
+    return {"KernelTable::tickEnvelopes", 0, [](const BenchConfig &) {
+                auto s = std::make_shared<State>();
+                for (int v = 0; v < VOICE_BANK_SIZE; ++v) {
+                    s->env.mul[v] = 0.999f; // Settles at add / (1 - mul) = 0.8
+                    s->env.add[v] = 0.0008f;
+                    s->gate[v] = 1.0f;
+                }
+                const KernelTable &kernels = selectKernels();
+                BenchInstance instance;
+                instance.body = [s, &kernels] { kernels.tickEnvelopes(s->env, s->gate, 0, VOICE_BANK_SIZE); };
+                instance.samplesPerCall = RENDER_SUB_BLOCK;
+                instance.voicesPerCall = MAX_VOICE_POLYPHONY;
+                instance.isa = kernels.name;
+                return instance;
+            }};
+}
+
+// LFO sines and ladder prewarp tangents for the whole voice bank, once per control period
+static Benchmark controlRateBenchmark() {
+    struct State {
+            VoiceLanes lanes;
+            alignas(64) float prewarpSource[VOICE_BANK_SIZE];
+            alignas(64) float prewarp[VOICE_BANK_SIZE];
+    };
+    return {"KernelTable::controlRate", 0, [](const BenchConfig &) {
+                auto s = std::make_shared<State>();
+                initLanes(s->lanes, MAX_VOICE_POLYPHONY);
+                for (int v = 0; v < VOICE_BANK_SIZE; ++v) s->prewarpSource[v] = 0.05f + 0.08f * static_cast<float>(v);
+                const KernelTable &kernels = selectKernels();
+                BenchInstance instance;
+                instance.body = [s, &kernels] {
+                    std::copy(std::begin(s->prewarpSource), std::end(s->prewarpSource), s->prewarp);
+                    kernels.controlRate(s->lanes, s->prewarp, 0, VOICE_BANK_SIZE);
+                };
+                instance.samplesPerCall = RENDER_SUB_BLOCK;
+                instance.voicesPerCall = MAX_VOICE_POLYPHONY;
+                instance.isa = kernels.name;
+                return instance;
+            }};
+}
+
+// Oscillators, filter and mix for the active voices over one control period
+static Benchmark renderBatchBenchmark() {
+    struct State {
+            VoiceLanes lanes;
+            BatchSetup setup;
+            std::vector<float> table = makeSawTable();
+            float filterMix[RENDER_SUB_BLOCK];
+            float mixL[RENDER_SUB_BLOCK];
+            float mixR[RENDER_SUB_BLOCK];
+    };
+    return {"KernelTable::renderBatch", AxisVoices | AxisUnison | AxisBypass, [](const BenchConfig &config) {
+                auto s = std::make_shared<State>();
+                initLanes(s->lanes, config.voices);
+                BatchSetup &setup = s->setup;
+                for (int lane = 0; lane < MAX_SIMD_WIDTH; ++lane) {
+                    for (int u = 0; u < maxUnison; ++u) {
+                        setup.detune[u][lane] = 1.0f + 0.01f * static_cast<float>(u);
+                        setup.unisonPhase[u][lane] = 0.1f * static_cast<float>(u);
+                        setup.unisonL[u][lane] = setup.unisonR[u][lane] = 0.5f / static_cast<float>(config.unison);
+                    }
+                    setup.mainMix[lane] = setup.subMix[lane] = setup.osc2Mix[lane] = 0.5f;
+                    setup.lfoDepth[lane] = setup.lfoPitch[lane] = 0.1f;
+                    setup.amp[lane] = 0.5f;
+                    setup.ampStep[lane] = 0.0f;
+                    setup.leftGain[lane] = setup.rightGain[lane] = 0.7f;
+                    setup.tables[lane] = setup.osc2Tables[lane] = s->table.data();
+                }
+                setup.unison = config.unison;
+                std::fill(std::begin(s->filterMix), std::end(s->filterMix), 1.0f);
+
+                const KernelTable &kernels = selectKernels();
+                const int batches = (config.voices + kernels.width - 1) / kernels.width;
+                const bool bypass = config.bypass;
+                BenchInstance instance;
+                instance.body = [s, &kernels, batches, bypass] {
+                    std::fill(std::begin(s->mixL), std::end(s->mixL), 0.0f);
+                    std::fill(std::begin(s->mixR), std::end(s->mixR), 0.0f);
+                    for (int b = 0; b < batches; ++b) {
+                        kernels.renderBatch(s->lanes, b * kernels.width, s->setup, RENDER_SUB_BLOCK, bypass, 0.995f,
+                                            s->filterMix, s->mixL, s->mixR);
+                    }
+                };
+                instance.samplesPerCall = RENDER_SUB_BLOCK;
+                instance.voicesPerCall = config.voices;
+                instance.isa = kernels.name;
+                return instance;
+            }};
+}
+
+// Engine at 48 kHz, no oversampling, with `voices` held notes past their attack
+static std::shared_ptr<SynthEngine> makePlayingEngine(const BenchConfig &config) {
+    auto engine = std::make_shared<SynthEngine>();
+    SynthParams params;
+    params.wavetable = config.waveform;
+    params.unison = config.unison;
+    params.filterBypass = config.bypass;
+    params.attack = 0.01f;
+    params.sustain = 1.0f;
+    engine->prepare(48000.0, 1);
+    engine->setParameters(params, true);
+
+    std::vector<SynthEvent> events;
+    for (int v = 0; v < config.voices; ++v) events.push_back({SynthEvent::Type::NoteOn, 0, 48 + (2 * v) % 80, 0.8f});
+    std::vector<float> left(4096), right(4096);
+    engine->render(events.data(), static_cast<int>(events.size()), left.data(), right.data(), 4096);
+    return engine;
+}
+
+// Applying a parameter change to every sounding voice, as render does after setParameters
+static Benchmark updateVoiceParametersBenchmark() {
+    return {"SynthEngine::updateVoiceParameters", AxisVoices, [](const BenchConfig &config) {
+                std::shared_ptr<SynthEngine> engine = makePlayingEngine(config);
+                auto flip = std::make_shared<bool>(false);
+                BenchInstance instance;
+                instance.body = [engine, flip] {
+                    SynthParams params = engine->getParameters();
+                    params.cutoff = (*flip = !*flip) ? 1500.0f : 2500.0f;
+                    engine->setParameters(params);
+                    engine->render(nullptr, 0, nullptr, nullptr, 0); // Applies the change and nothing else
+                };
+                instance.voicesPerCall = config.voices;
+                instance.isa = engine->getKernels().name;
+                return instance;
+            }};
+}
+
+// A note-on and its note-off with every slot sounding, so each note-on steals: a glissando over a full bank
+static Benchmark noteOnOffBenchmark() {
+    return {"SynthEngine::noteOnOff", 0, [](const BenchConfig &config) {
+                BenchConfig full = config;
+                full.voices = MAX_VOICE_POLYPHONY;
+                std::shared_ptr<SynthEngine> engine = makePlayingEngine(full);
+                auto note = std::make_shared<int>(0);
+                BenchInstance instance;
+                instance.body = [engine, note] {
+                    *note = (*note + 7) % 128;
+                    const SynthEvent events[] = {{SynthEvent::Type::NoteOn, 0, *note, 0.8f},
+                                                 {SynthEvent::Type::NoteOff, 0, *note, 0.0f}};
+                    engine->render(events, 2, nullptr, nullptr, 0); // Applies the events and nothing else
+                };
+                instance.isa = engine->getKernels().name;
+                return instance;
+            }};
+}
+
+// A whole engine block: envelopes, control rate, voices and mix
+static Benchmark engineRenderBenchmark() {
+    return {"SynthEngine::render", AxisVoices | AxisUnison | AxisWaveform | AxisBypass | AxisBlock,
+            [](const BenchConfig &config) {
+                std::shared_ptr<SynthEngine> engine = makePlayingEngine(config);
+                auto output = std::make_shared<std::vector<float>>(2 * static_cast<size_t>(config.block));
+                const int block = config.block;
+                BenchInstance instance;
+                instance.body = [engine, output, block] {
+                    engine->render(nullptr, 0, output->data(), output->data() + block, block);
+                };
+                instance.samplesPerCall = block;
+                instance.voicesPerCall = config.voices;
+                instance.isa = engine->getKernels().name;
+                return instance;
+            }};
+}
+
+// SynthEngine::render paced like a host, one block per block period at 48 kHz, with only the render timed. With
+// SIMDSYNTH_WORKERS set it renders on the shared worker pool, which sits idle between blocks as it does in a
+// plugin, so this includes what it costs the audio thread to get the workers going again.
+static Benchmark engineRealtimeBenchmark() {
+    return {"SynthEngine::render/realtime", AxisVoices | AxisUnison | AxisBlock, [](const BenchConfig &config) {
+                struct State {
+                        std::shared_ptr<WorkerPool> pool; // Outlives the engine
+                        std::shared_ptr<SynthEngine> engine;
+                        std::vector<float> output;
+                        std::vector<double> renderNs; // Every call's render time
+                };
+                auto state = std::make_shared<State>();
+                state->pool = WorkerPool::acquire();
+                state->engine = makePlayingEngine(config);
+                state->engine->setWorkerPool(state->pool.get());
+                state->output.resize(2 * static_cast<size_t>(config.block));
+                const int block = config.block;
+                const auto period = std::chrono::duration<double>(block / 48000.0);
+
+                BenchInstance instance;
+                instance.body = [state, block, period] {
+                    const auto start = std::chrono::steady_clock::now();
+                    state->engine->render(nullptr, 0, state->output.data(), state->output.data() + block, block);
+                    const auto end = std::chrono::steady_clock::now();
+                    state->renderNs.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+                    std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::nanoseconds>(period));
+                };
+                instance.report = [state](BenchResult &result) {
+                    std::vector<double> &times = state->renderNs;
+                    std::sort(times.begin(), times.end());
+                    const double median = times[times.size() / 2];
+                    result.nsPerSampleVoice *= median / result.nsPerCall;
+                    result.nsPerCall = median;
+                    result.nsPerCallMin = times.front();
+                };
+                instance.samplesPerCall = block;
+                instance.voicesPerCall = config.voices;
+                instance.isa = state->engine->getKernels().name;
+                return instance;
+            }};
+}
+
+void registerKernelBenchmarks(BenchmarkSuite &suite) {
+    addBuildingBlocks<simd::Vec<simd::Scalar>>(suite, "scalar");
+#if defined(__SSE4_1__)
+    addBuildingBlocks<simd::Vec<simd::Sse41>>(suite, "sse4.1");
+#elif defined(__aarch64__) || defined(__arm64__)
+    addBuildingBlocks<simd::Vec<simd::Neon>>(suite, "neon");
+#endif
+    suite.add(tickEnvelopesBenchmark());
+    suite.add(controlRateBenchmark());
+    suite.add(renderBatchBenchmark());
+    suite.add(updateVoiceParametersBenchmark());
+    suite.add(noteOnOffBenchmark());
+    suite.add(engineRenderBenchmark());
+    suite.add(engineRealtimeBenchmark());
+}
@@ -0,0 +1,160 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// ProcessorBenchmarks.cpp - Benchmarks for the plugin side: the oversampler, a full processBlock, and instance
+// startup as a host sees it when it loads a project.
+
+#include <JuceHeader.h>
+#include "Benchmark.h"
+#include "PluginProcessor.h"
+
+#include <cmath>
+#include <memory>
+
+// Oversampler round trip for a stereo host block, as processBlock runs it
+static Benchmark oversamplingBenchmark(int stages) {
+    struct State {
+            std::unique_ptr<juce::dsp::Oversampling<float>> oversampling;
+            juce::AudioBuffer<float> buffer;
+    };
+    const std::string name = "juce::dsp::Oversampling/" + std::to_string(1 << stages) + "x";
+    return {name, AxisBlock, [stages](const BenchConfig &config) {
+                auto s = std::make_shared<State>();
+                s->oversampling = std::make_unique<juce::dsp::Oversampling<float>>(
+                    2, stages, juce::dsp::Oversampling<float>::FilterType::filterHalfBandPolyphaseIIR, true, true);
+                s->oversampling->initProcessing(static_cast<size_t>(config.block));
+                s->buffer.setSize(2, config.block);
+                for (int ch = 0; ch < 2; ++ch) {
+                    for (int n = 0; n < config.block; ++n) s->buffer.setSample(ch, n, std::sin(0.01f * n));
+                }
+                BenchInstance instance;
+                instance.body = [s] {
+                    juce::dsp::AudioBlock<float> block(s->buffer);
+                    s->oversampling->processSamplesUp(block);
+                    s->oversampling->processSamplesDown(block);
+                };
+                instance.samplesPerCall = config.block;
+                instance.isa = "juce";
+                instance.oversampling = 1 << stages;
+                return instance;
+            }};
+}
+
+static void setParameter(SimdSynthAudioProcessor &processor, const char *parameterID, float value) {
+    if (auto *param = dynamic_cast<juce::RangedAudioParameter *>(processor.getParameters().getParameter(parameterID)))
+        param->setValueNotifyingHost(param->convertTo0to1(value));
+}
+
+// A full host block with `voices` held notes, oversampling in Auto mode
+static Benchmark processBlockBenchmark() {
+    struct State {
+            juce::ScopedJuceInitialiser_GUI juceInit; // Message manager for the processor's parameters
+            SimdSynthAudioProcessor processor;
+            juce::AudioBuffer<float> buffer;
+            juce::MidiBuffer midi;
+            ProfileSnapshot start; // Stage totals before the timed calls
+    };
+    return {"SimdSynthAudioProcessor::processBlock", AxisVoices | AxisUnison | AxisWaveform | AxisBypass | AxisBlock,
+            [](const BenchConfig &config) {
+                auto s = std::make_shared<State>();
+                SimdSynthAudioProcessor &processor = s->processor;
+                setParameter(processor, "wavetable", static_cast<float>(config.waveform));
+                setParameter(processor, "unison", static_cast<float>(config.unison));
+                setParameter(processor, "filterBypass", config.bypass ? 1.0f : 0.0f);
+                setParameter(processor, "attack", 0.01f);
+                setParameter(processor, "sustain", 1.0f);
+                processor.setRateAndBufferSizeDetails(48000.0, config.block);
+                processor.prepareToPlay(48000.0, config.block);
+                s->buffer.setSize(2, config.block);
+
+                // Start the notes and play them past the attack
+                for (int v = 0; v < config.voices; ++v) {
+                    s->midi.addEvent(juce::MidiMessage::noteOn(1, 48 + (2 * v) % 80, 0.8f), 0);
+                }
+                for (int n = 0; n < 4096; n += config.block) {
+                    processor.processBlock(s->buffer, s->midi);
+                    s->midi.clear();
+                }
+                processor.readProfile(s->start);
+
+                BenchInstance instance;
+                instance.body = [s] { s->processor.processBlock(s->buffer, s->midi); };
+                // Stage times per block over the timed and calibration calls, in profiling builds
+                instance.report = [s](BenchResult &result) {
+                    ProfileSnapshot end;
+                    if (!s->processor.readProfile(end) || end.blocks <= s->start.blocks) return;
+                    const double blocks = static_cast<double>(end.blocks - s->start.blocks);
+                    for (int stage = 0; stage < NUM_PROFILE_STAGES; ++stage) {
+                        const uint64_t ticks = end.stageTicks[stage] - s->start.stageTicks[stage];
+                        result.stages.emplace_back(PROFILE_STAGE_NAMES[stage], 1.0e9 * end.seconds(ticks) / blocks);
+                    }
+                };
+                instance.samplesPerCall = config.block;
+                instance.voicesPerCall = config.voices;
+                instance.isa = processor.getEngine().getKernels().name;
+                instance.oversampling = processor.getEngine().getOversamplingFactor();
+                return instance;
+            }};
+}
+
+// Stages of bringing up an instance, timed on their own and together
+enum class StartupStage { Construct, Prepare, Editor, Instance };
+
+// Construction includes destruction, since a project load that replaces instances pays for both. The editor is
+// created and made active, then closed.
+static Benchmark startupBenchmark(StartupStage stage) {
+    struct State {
+            juce::ScopedJuceInitialiser_GUI juceInit; // Message manager for the processor and its editor
+            std::unique_ptr<SimdSynthAudioProcessor> processor;
+            int block = 512;
+    };
+    static const char *const names[] = {"Startup/construct", "Startup/prepareToPlay", "Startup/createEditor",
+                                        "Startup/instance"};
+    const unsigned axes = stage == StartupStage::Construct ? 0u : static_cast<unsigned>(AxisBlock);
+    return {names[static_cast<int>(stage)], axes, [stage](const BenchConfig &config) {
+                auto s = std::make_shared<State>();
+                s->block = config.block;
+                s->processor = std::make_unique<SimdSynthAudioProcessor>();
+                s->processor->setRateAndBufferSizeDetails(48000.0, config.block);
+                s->processor->prepareToPlay(48000.0, config.block);
+
+                BenchInstance instance;
+                switch (stage) {
+                case StartupStage::Construct:
+                    instance.body = [] { SimdSynthAudioProcessor processor; };
+                    break;
+                case StartupStage::Prepare:
+                    instance.body = [s] { s->processor->prepareToPlay(48000.0, s->block); };
+                    break;
+                case StartupStage::Editor:
+                    instance.body = [s] {
+                        std::unique_ptr<juce::AudioProcessorEditor> editor(s->processor->createEditorAndMakeActive());
+                    };
+                    break;
+                case StartupStage::Instance:
+                    instance.body = [s] {
+                        SimdSynthAudioProcessor processor;
+                        processor.setRateAndBufferSizeDetails(48000.0, s->block);
+                        processor.prepareToPlay(48000.0, s->block);
+                        std::unique_ptr<juce::AudioProcessorEditor> editor(processor.createEditorAndMakeActive());
+                    };
+                    break;
+                }
+                instance.isa = s->processor->getEngine().getKernels().name;
+                return instance;
+            }};
+}
+
+void registerProcessorBenchmarks(BenchmarkSuite &suite) {
+    for (int stages = 1; stages <= 3; ++stages) suite.add(oversamplingBenchmark(stages));
+    suite.add(processBlockBenchmark());
+    for (StartupStage stage : {StartupStage::Construct, StartupStage::Prepare, StartupStage::Editor,
+                               StartupStage::Instance}) {
+        suite.add(startupBenchmark(stage));
+    }
+}
@@ -0,0 +1,120 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// ParameterRegistry.h - The synth's parameters in one table: ID, range, default, smoothing time and the per-voice
+// values each one feeds. The plugin builds its parameter layout, listeners and preset fields from it, and the
+// engine its change tracking and smoothers; everything else refers to parameters by ParameterIndex.
+#pragma once
+
+// Per-voice values derived from the parameters, in groups the engine refreshes independently
+enum VoiceParamGroup : unsigned {
+    GroupEnvelope = 1 << 0, // Envelope times, levels and curves
+    GroupFilter = 1 << 1,   // Cutoff, resonance and filter envelope amount
+    GroupPitch = 1 << 2,    // Sub and second oscillator tuning, and the phase increments
+    GroupUnison = 1 << 3,   // Unison count and detune factors
+    GroupMix = 1 << 4,      // Oscillator mix, LFO and waveform
+    GroupAll = (1 << 5) - 1
+};
+
+// Position of each parameter in PARAMETERS, and in the plugin's parameter list
+enum ParameterIndex : int {
+    ParamWavetable,
+    ParamAttack,
+    ParamDecay,
+    ParamSustain,
+    ParamRelease,
+    ParamAttackCurve,
+    ParamReleaseCurve,
+    ParamFilterBypass,
+    ParamCutoff,
+    ParamResonance,
+    ParamFegAttack,
+    ParamFegDecay,
+    ParamFegSustain,
+    ParamFegRelease,
+    ParamFegAmount,
+    ParamFilterMix,
+    ParamLfoRate,
+    ParamLfoDepth,
+    ParamLfoPitchAmt,
+    ParamSubTune,
+    ParamSubMix,
+    ParamSubTrack,
+    ParamOsc2Tune,
+    ParamOsc2Mix,
+    ParamOsc2Track,
+    ParamGain,
+    ParamUnison,
+    ParamDetune,
+    ParamOversampling,
+    NUM_PARAMETERS
+};
+
+enum ParameterFlags : unsigned {
+    FlagInPreset = 1 << 0,     // Stored in preset files
+    FlagInteger = 1 << 1,      // Whole numbers only
+    FlagOversampling = 1 << 2, // Feeds the automatic oversampling choice
+};
+
+struct ParameterSpec {
+        ParameterIndex index;          // Position in PARAMETERS
+        const char *id;                // Parameter ID, also the preset key
+        const char *name;              // Display name
+        float min, max;                // Range; for choices, 0 to the number of choices minus one
+        float defaultValue;            // Also used for fields a preset leaves out
+        unsigned voiceGroups;          // VoiceParamGroup bits to refresh on a change; 0 for engine-wide values
+        unsigned flags;                // ParameterFlags
+        double smoothingSeconds = 0.0; // Ramp time of the engine's smoother, or 0 when changes apply at once
+        const char *choices = nullptr; // "|"-separated choice names, or null for a numeric parameter
+};
+
+inline constexpr double SMOOTHED = 0.01; // Ramp time of the smoothed parameters
+
+inline constexpr ParameterSpec PARAMETERS[NUM_PARAMETERS] = {
+    {ParamWavetable, "wavetable", "Wavetable Type", 0.0f, 2.0f, 0.0f, GroupMix,
+     FlagInPreset | FlagInteger | FlagOversampling},
+    {ParamAttack, "attack", "Attack Time", 0.01f, 5.0f, 0.1f, GroupEnvelope, FlagInPreset},
+    {ParamDecay, "decay", "Decay Time", 0.1f, 5.0f, 0.5f, GroupEnvelope, FlagInPreset},
+    {ParamSustain, "sustain", "Sustain Level", 0.0f, 1.0f, 0.8f, GroupEnvelope, FlagInPreset},
+    {ParamRelease, "release", "Release Time", 0.01f, 5.0f, 0.2f, GroupEnvelope, FlagInPreset},
+    {ParamAttackCurve, "attackCurve", "Attack Curve", 0.5f, 5.0f, 2.0f, GroupEnvelope, FlagInPreset, SMOOTHED},
+    {ParamReleaseCurve, "releaseCurve", "Release Curve", 0.5f, 5.0f, 3.0f, GroupEnvelope, FlagInPreset, SMOOTHED},
+    {ParamFilterBypass, "filterBypass", "Filter Bypass", 0.0f, 1.0f, 0.0f, GroupFilter,
+     FlagInPreset | FlagOversampling},
+    {ParamCutoff, "cutoff", "Filter Cutoff", 20.0f, 20000.0f, 2000.0f, GroupFilter, FlagInPreset, SMOOTHED},
+    {ParamResonance, "resonance", "Filter Resonance", 0.0f, 1.0f, 0.9f, GroupFilter,
+     FlagInPreset | FlagOversampling, SMOOTHED},
+    {ParamFegAttack, "fegAttack", "Filter EG Attack", 0.01f, 5.0f, 0.1f, GroupEnvelope, FlagInPreset},
+    {ParamFegDecay, "fegDecay", "Filter EG Decay", 0.1f, 5.0f, 1.0f, GroupEnvelope, FlagInPreset},
+    {ParamFegSustain, "fegSustain", "Filter EG Sustain", 0.0f, 1.0f, 0.8f, GroupEnvelope, FlagInPreset},
+    {ParamFegRelease, "fegRelease", "Filter EG Release", 0.01f, 5.0f, 0.2f, GroupEnvelope, FlagInPreset},
+    {ParamFegAmount, "fegAmount", "Filter EG Amount", -1.0f, 1.0f, 0.8f, GroupFilter, FlagInPreset, SMOOTHED},
+    {ParamFilterMix, "filterMix", "Filter Mix", 0.0f, 1.0f, 1.0f, 0, 0, SMOOTHED},
+    {ParamLfoRate, "lfoRate", "LFO Rate", 0.0f, 20.0f, 5.0f, GroupMix, FlagInPreset, SMOOTHED},
+    {ParamLfoDepth, "lfoDepth", "LFO Depth", 0.0f, 1.0f, 0.5f, GroupMix, FlagInPreset, SMOOTHED},
+    {ParamLfoPitchAmt, "lfoPitchAmt", "LFO Pitch Amt", 0.0f, 0.5f, 0.1f, GroupMix, FlagInPreset},
+    {ParamSubTune, "subTune", "Sub Osc Tune", -24.0f, 24.0f, -12.0f, GroupPitch, FlagInPreset, SMOOTHED},
+    {ParamSubMix, "subMix", "Sub Osc Mix", 0.0f, 1.0f, 0.7f, GroupMix, FlagInPreset, SMOOTHED},
+    {ParamSubTrack, "subTrack", "Sub Osc Track", 0.0f, 1.0f, 1.0f, GroupPitch, FlagInPreset, SMOOTHED},
+    {ParamOsc2Tune, "osc2Tune", "Osc 2 Tune", -12.0f, 12.0f, 0.0f, GroupPitch, FlagInPreset, SMOOTHED},
+    {ParamOsc2Mix, "osc2Mix", "Osc 2 Mix", 0.0f, 1.0f, 0.5f, GroupMix, FlagInPreset, SMOOTHED},
+    {ParamOsc2Track, "osc2Track", "Osc 2 Track", 0.0f, 1.0f, 1.0f, GroupPitch, FlagInPreset, SMOOTHED},
+    {ParamGain, "gain", "Output Gain", 0.0f, 2.0f, 1.0f, 0, FlagInPreset, SMOOTHED},
+    {ParamUnison, "unison", "Unison Voices", 1.0f, 8.0f, 1.0f, GroupUnison, FlagInPreset | FlagInteger},
+    {ParamDetune, "detune", "Unison Detune", 0.0f, 0.1f, 0.01f, GroupUnison, FlagInPreset, SMOOTHED},
+    {ParamOversampling, "oversampling", "Oversampling", 0.0f, 4.0f, 0.0f, 0, FlagOversampling, 0.0,
+     "Auto|1x|2x|4x|8x"},
+};
+
+static constexpr bool parametersInIndexOrder() {
+    for (int i = 0; i < NUM_PARAMETERS; ++i) {
+        if (PARAMETERS[i].index != i) return false;
+    }
+    return true;
+}
+static_assert(parametersInIndexOrder(), "PARAMETERS must be in ParameterIndex order");
@@ -1,13 +1,43 @@
 /*
  * simdsynth - a playground for experimenting with SIMD-based audio
  *             synthesis, with polyphonic main and sub-oscillator,
- *             filter, envelopes, and LFO per voice, up to 16 voices.
+ *             filter, envelopes, and LFO per voice, with configurable polyphony.
  *
  * MIT Licensed, (c) 2025, seclorum
  */
 
 #include "PluginEditor.h"
 
+#if SIMDSYNTH_PROFILING
+ProfileView::ProfileView(SimdSynthAudioProcessor &p) : juce::Label("profileView"), processor(p) {
+    setFont(juce::Font(juce::FontOptions(12.0f)));
+    setColour(juce::Label::textColourId, juce::Colours::lightgrey);
+    startTimerHz(4);
+}
+
+void ProfileView::timerCallback() {
+    ProfileSnapshot latest;
+    if (!processor.readProfile(latest)) return;
+    if (latest.blocks < previous.blocks) previous = {}; // Prepared again since the last update
+    const uint64_t blocks = latest.blocks - previous.blocks;
+    if (blocks == 0) return;
+
+    juce::String text;
+    for (int s = 0; s < NUM_PROFILE_STAGES; ++s) {
+        const double micros = 1.0e6 * latest.seconds(latest.stageTicks[s] - previous.stageTicks[s]) / blocks;
+        text << PROFILE_STAGE_NAMES[s] << " " << juce::String(micros, 1) << "  ";
+    }
+    const double audioSeconds = latest.audioSeconds - previous.audioSeconds;
+    const double deadlinePercent = 100.0 * latest.seconds(latest.blockTicks - previous.blockTicks) / audioSeconds;
+    text << "us/block | " << latest.activeVoices << " voices | deadline " << juce::String(deadlinePercent, 1)
+         << "%, last " << juce::String(latest.lastDeadlinePercent, 1) << "%, worst "
+         << juce::String(latest.worstDeadlinePercent, 1) << "% (" << juce::String(1.0e6 * latest.worstBlockSeconds, 0)
+         << " us)";
+    setText(text, juce::dontSendNotification);
+    previous = latest;
+}
+#endif
+
 SimdSynthAudioProcessorEditor::SimdSynthAudioProcessorEditor(SimdSynthAudioProcessor &p)
     : AudioProcessorEditor(&p), processor(p) {
     // Apply custom LookAndFeel
@@ -59,6 +89,18 @@ SimdSynthAudioProcessorEditor::SimdSynthAudioProcessorEditor(SimdSynthAudioProce
     };
     addAndMakeVisible(loadButton.get());
 
+    oversamplingComboBox = std::make_unique<juce::ComboBox>("oversamplingComboBox");
+    oversamplingComboBox->addItemList({"Auto", "1x", "2x", "4x", "8x"}, 1);
+    oversamplingComboBox->setTooltip("Oversampling");
+    oversamplingAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        processor.getParameters(), "oversampling", *oversamplingComboBox);
+    addAndMakeVisible(oversamplingComboBox.get());
+
+#if SIMDSYNTH_PROFILING
+    profileView = std::make_unique<ProfileView>(processor);
+    addAndMakeVisible(profileView.get());
+#endif
+
     // Initialize group components
     oscillatorGroup = std::make_unique<juce::GroupComponent>("oscillatorGroup", "Oscillator");
     addAndMakeVisible(oscillatorGroup.get());
@@ -387,6 +429,7 @@ SimdSynthAudioProcessorEditor::SimdSynthAudioProcessorEditor(SimdSynthAudioProce
     presetNameEditor->setVisible(true);
     confirmButton->setVisible(true);
     loadButton->setVisible(true);
+    oversamplingComboBox->setVisible(true);
     oscillatorGroup->setVisible(true);
     ampEnvelopeGroup->setVisible(true);
     filterGroup->setVisible(true);
@@ -453,6 +496,9 @@ void SimdSynthAudioProcessorEditor::resized() {
     }
 
     auto presetArea = bounds.removeFromTop(50).reduced(5);
+#if SIMDSYNTH_PROFILING
+    profileView->setBounds(bounds.removeFromBottom(24).reduced(10, 2));
+#endif
     auto controlArea = bounds.reduced(15);
 
     // Layout preset controls using FlexBox
@@ -463,6 +509,7 @@ void SimdSynthAudioProcessorEditor::resized() {
     presetBox.items.add(juce::FlexItem(*presetNameEditor).withFlex(1).withMargin(5));
     presetBox.items.add(juce::FlexItem(*confirmButton).withFlex(1).withMargin(5));
     presetBox.items.add(juce::FlexItem(*loadButton).withFlex(1).withMargin(5));
+    presetBox.items.add(juce::FlexItem(*oversamplingComboBox).withFlex(1).withMargin(5));
     presetBox.performLayout(presetArea);
 
     // Layout groups using Grid
@@ -1,7 +1,7 @@
 /*
  * simdsynth - a playground for experimenting with SIMD-based audio
  *             synthesis, with polyphonic main and sub-oscillator,
- *             filter, envelopes, and LFO per voice, up to 16 voices.
+ *             filter, envelopes, and LFO per voice, with configurable polyphony.
  *
  * MIT Licensed, (c) 2025, seclorum
  */
@@ -39,6 +39,21 @@ class CustomLookAndFeel : public juce::LookAndFeel_V4 {
         }
 };
 
+#if SIMDSYNTH_PROFILING
+// One line of audio-thread timings under the controls, over the last update: time per block in each stage, the
+// sounding voices, and how much of the block deadline the blocks took
+class ProfileView : public juce::Label, private juce::Timer {
+    public:
+        explicit ProfileView(SimdSynthAudioProcessor &p);
+
+    private:
+        void timerCallback() override;
+
+        SimdSynthAudioProcessor &processor;
+        ProfileSnapshot previous; // Totals at the last update
+};
+#endif
+
 class SimdSynthAudioProcessorEditor : public juce::AudioProcessorEditor, public juce::ComboBox::Listener {
     public:
         explicit SimdSynthAudioProcessorEditor(SimdSynthAudioProcessor &p);
@@ -64,6 +79,11 @@ class SimdSynthAudioProcessorEditor : public juce::AudioProcessorEditor, public
         std::unique_ptr<juce::TextEditor> presetNameEditor;
         std::unique_ptr<juce::TextButton> confirmButton;
         std::unique_ptr<juce::TextButton> loadButton;
+        std::unique_ptr<juce::ComboBox> oversamplingComboBox;
+        std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> oversamplingAttachment;
+#if SIMDSYNTH_PROFILING
+        std::unique_ptr<ProfileView> profileView;
+#endif
 
         // Group components
         std::unique_ptr<juce::GroupComponent> oscillatorGroup;
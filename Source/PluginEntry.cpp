@@ -1,7 +1,7 @@
 /*
  * simdsynth - a playground for experimenting with SIMD-based audio
  *             synthesis, with polyphonic main and sub-oscillator,
- *             filter, envelopes, and LFO per voice, up to 16 voices.
+ *             filter, envelopes, and LFO per voice, with configurable polyphony.
  *
  * MIT Licensed, (c) 2025, seclorum
  */
@@ -0,0 +1,348 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+#include "PresetLibrary.h"
+#include "PresetManager.h"
+
+#include <cstring>
+
+// Bank file layout: BankHeader, numPresets BankName entries, numPresets Preset records, then textSize bytes of
+// name text. Everything is in native byte order; a bank from another build or machine fails the layout check and
+// is rebuilt.
+struct PresetLibrary::BankHeader {
+        char magic[8];             // BANK_MAGIC
+        uint32_t layout;           // bankLayout() of the build that wrote it
+        uint32_t numPresets;       // Entries in the name index and records
+        uint32_t textSize;         // Bytes of name text after the records
+        uint32_t numFiles;         // Preset files the bank was built from
+        uint64_t filesHash;        // Sources::hash of those files
+};
+
+struct PresetLibrary::BankName {
+        uint32_t offset, length; // UTF-8 name in the text section, in bytes
+};
+
+static constexpr char BANK_MAGIC[8] = {'S', 'S', 'Y', 'N', 'B', 'A', 'N', 'K'};
+static constexpr uint32_t BANK_FORMAT = 2; // Version of the header layout
+
+// Hash of what a bank depends on besides the preset files: the header format, the parameter IDs in table order, the
+// record size and the factory presets. A change to any of them makes old banks stale.
+static uint32_t bankLayout() {
+    static const uint32_t layout = [] {
+        uint32_t hash = 2166136261u;
+        auto mix = [&hash](const void *data, size_t size) {
+            for (size_t i = 0; i < size; ++i) hash = (hash ^ static_cast<const unsigned char *>(data)[i]) * 16777619u;
+        };
+        mix(&BANK_FORMAT, sizeof(BANK_FORMAT));
+        for (const ParameterSpec &spec : PARAMETERS) mix(spec.id, std::strlen(spec.id) + 1);
+        const uint32_t recordSize = sizeof(PresetLibrary::Preset);
+        mix(&recordSize, sizeof(recordSize));
+        for (int i = 0; i < PresetManager::getNumFactoryPresets(); ++i) {
+            const char *name = PresetManager::getFactoryPresetName(i);
+            mix(name, std::strlen(name) + 1);
+            mix(&PresetManager::getFactoryPreset(i), sizeof(PresetLibrary::Preset));
+        }
+        return hash;
+    }();
+    return layout;
+}
+
+SynthParams PresetLibrary::Preset::applyTo(SynthParams params) const {
+    for (int i = 0; i < NUM_PARAMETERS; ++i) {
+        if (fields & (1u << i)) setParameterValue(params, i, values[static_cast<size_t>(i)]);
+    }
+    return params;
+}
+
+bool PresetLibrary::Bank::attach(const void *data, size_t size) {
+    header = nullptr;
+    if (data == nullptr || size < sizeof(BankHeader)) return false;
+    const auto *bytes = static_cast<const char *>(data);
+    const auto *head = reinterpret_cast<const BankHeader *>(bytes);
+    if (std::memcmp(head->magic, BANK_MAGIC, sizeof(BANK_MAGIC)) != 0 || head->layout != bankLayout()) return false;
+
+    const size_t count = head->numPresets;
+    const size_t namesAt = sizeof(BankHeader);
+    const size_t presetsAt = namesAt + count * sizeof(BankName);
+    const size_t textAt = presetsAt + count * sizeof(Preset);
+    if (count > 65536 || textAt + head->textSize != size) return false;
+
+    names = reinterpret_cast<const BankName *>(bytes + namesAt);
+    presets = reinterpret_cast<const Preset *>(bytes + presetsAt);
+    text = bytes + textAt;
+
+    // The records are used without further checks, so reject anything a parsed preset could not hold
+    for (size_t i = 0; i < count; ++i) {
+        if (names[i].offset > head->textSize || names[i].length > head->textSize - names[i].offset) return false;
+        if (presets[i].fields >> NUM_PARAMETERS != 0) return false;
+        for (const ParameterSpec &spec : PARAMETERS) {
+            const float value = presets[i].values[static_cast<size_t>(spec.index)];
+            if ((presets[i].fields & (1u << spec.index)) && !(value >= spec.min && value <= spec.max)) return false;
+        }
+    }
+    header = head;
+    return true;
+}
+
+// Keeps the current bank alive while one reader uses it. Wait-free; publish() waits for the readers instead.
+class PresetLibrary::BankReader {
+    public:
+        explicit BankReader(const PresetLibrary &library) : readers(library.readers) {
+            readers.fetch_add(1); // Sequentially consistent with publish(), so a reader it misses sees the new bank
+            bank = library.bank.load();
+        }
+        ~BankReader() { readers.fetch_sub(1, std::memory_order_release); }
+        BankReader(const BankReader &) = delete;
+        BankReader &operator=(const BankReader &) = delete;
+
+        const Bank *bank; // Null before the first bank is published
+
+    private:
+        std::atomic<int> &readers;
+};
+
+PresetLibrary::PresetLibrary(const juce::File &presetDirectory) : directory(presetDirectory) {}
+
+PresetLibrary::~PresetLibrary() {
+    waitUntilIdle(); // Let a pending write or rebuild finish
+    cancelPendingUpdate();
+}
+
+bool PresetLibrary::parse(const juce::File &file, Preset &preset) {
+    const juce::String name = file.getFileNameWithoutExtension();
+    preset.fields = 0;
+
+    if (!file.existsAsFile()) {
+        DBG("Error: Preset file not found: " << file.getFullPathName());
+        return false;
+    }
+
+    // FIX: Stricter JSON validation
+    auto parsedJson = juce::JSON::parse(file.loadFileAsString());
+    if (!parsedJson.isObject()) {
+        DBG("Error: Invalid JSON format in preset: " << name);
+        return false;
+    }
+
+    juce::var synthParams = parsedJson.getProperty("SimdSynth", juce::var());
+    const bool valid = synthParams.isObject();
+    if (!valid) DBG("Error: 'SimdSynth' object not found in preset: " << name);
+
+    for (const ParameterSpec &spec : PARAMETERS) {
+        if ((spec.flags & FlagInPreset) == 0) continue;
+        float value = spec.defaultValue;
+        juce::var prop = valid ? synthParams.getProperty(spec.id, juce::var()) : juce::var();
+        if (!prop.isVoid()) {
+            if (prop.isDouble() || prop.isInt() || prop.isInt64()) {
+                value = static_cast<float>(prop);
+            } else {
+                DBG("Warning: Invalid type for " << spec.id << " in preset: " << name);
+                continue;
+            }
+        } else if (valid) {
+            DBG("Warning: Missing parameter " << spec.id << " in preset: " << name);
+        }
+        if (spec.flags & FlagInteger) {
+            value = std::round(value);
+        }
+        preset.values[static_cast<size_t>(spec.index)] = juce::jlimit(spec.min, spec.max, value);
+        preset.fields |= 1u << spec.index;
+    }
+    return valid;
+}
+
+juce::var PresetLibrary::toJson(const Preset &preset) {
+    juce::DynamicObject::Ptr root = new juce::DynamicObject();
+    juce::DynamicObject::Ptr synth = new juce::DynamicObject();
+    for (const ParameterSpec &spec : PARAMETERS) {
+        if (preset.fields & (1u << spec.index)) {
+            synth->setProperty(spec.id, preset.values[static_cast<size_t>(spec.index)]);
+        }
+    }
+    root->setProperty("SimdSynth", juce::var(synth.get()));
+    return juce::var(root.get());
+}
+
+// Editing a file in place does not change the directory's date on most file systems, so every file's size and
+// date go into the hash
+PresetLibrary::Sources PresetLibrary::scanSources() const {
+    Sources sources;
+    if (!directory.isDirectory()) return sources;
+    directory.findChildFiles(sources.files, juce::File::findFiles, false, "*.json");
+    sources.files.sort(); // Program numbers of the user presets follow the file names
+
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void *data, size_t size) {
+        const auto *bytes = static_cast<const unsigned char *>(data);
+        for (size_t i = 0; i < size; ++i) hash = (hash ^ bytes[i]) * 1099511628211ull;
+    };
+    for (const juce::File &file : sources.files) {
+        const juce::String name = file.getFileName();
+        const juce::int64 size = file.getSize();
+        const juce::int64 modified = file.getLastModificationTime().toMilliseconds();
+        mix(name.toRawUTF8(), name.getNumBytesAsUTF8() + 1);
+        mix(&size, sizeof(size));
+        mix(&modified, sizeof(modified));
+    }
+    sources.hash = hash;
+    return sources;
+}
+
+void PresetLibrary::open() {
+    const bool hasDirectory = directory.isDirectory();
+    const Sources sources = scanSources();
+    auto mapped = std::make_unique<Bank>();
+    const juce::File bankFile = getBankFile();
+    if (hasDirectory && bankFile.existsAsFile()) {
+        mapped->mapping = std::make_unique<juce::MemoryMappedFile>(bankFile, juce::MemoryMappedFile::readOnly);
+        mapped->attach(mapped->mapping->getData(), mapped->mapping->getSize());
+    }
+    if (mapped->header != nullptr && mapped->header->numFiles == static_cast<uint32_t>(sources.files.size()) &&
+        mapped->header->filesHash == sources.hash) {
+        publish(std::move(mapped));
+        return;
+    }
+
+    // Until the rebuild is done an out of date bank serves, or the factory presets alone. Factory presets come
+    // first in every bank, so their program numbers do not change. Without a preset directory there is nothing
+    // to rebuild from, and nothing is written.
+    publish(mapped->header != nullptr ? std::move(mapped) : compileBank({}));
+    if (hasDirectory) {
+        DBG("Preset bank missing or out of date, rebuilding: " << bankFile.getFullPathName());
+        rebuild();
+    }
+}
+
+void PresetLibrary::rebuild() {
+    worker.addJob([this] { rebuildNow(); });
+}
+
+void PresetLibrary::rebuildNow() {
+    // The files are hashed before they are read, so one changed while the bank is built makes it stale again
+    std::unique_ptr<Bank> built = compileBank(scanSources());
+    if (built->header == nullptr) return;
+
+    // Other instances map the file. If it cannot be replaced, say while another process has it mapped on
+    // Windows, this library still uses the bank it built, and the next one to open it rebuilds it again.
+    juce::TemporaryFile temp(getBankFile());
+    if (!temp.getFile().replaceWithData(built->built.getData(), built->built.getSize()) ||
+        !temp.overwriteTargetFileWithTemporary()) {
+        DBG("Failed to write preset bank: " << getBankFile().getFullPathName());
+    }
+
+    publish(std::move(built));
+    triggerAsyncUpdate();
+}
+
+std::unique_ptr<PresetLibrary::Bank> PresetLibrary::compileBank(const Sources &sources) {
+    auto built = std::make_unique<Bank>();
+    built->built = buildBank(sources);
+    const bool valid = built->attach(built->built.getData(), built->built.getSize());
+    jassert(valid);
+    juce::ignoreUnused(valid);
+    return built;
+}
+
+// The factory presets, then the preset files in order. A file with a factory preset's name replaces it.
+juce::MemoryBlock PresetLibrary::buildBank(const Sources &sources) {
+    juce::StringArray names;
+    std::vector<Preset> presets;
+    for (int i = 0; i < PresetManager::getNumFactoryPresets(); ++i) {
+        names.add(PresetManager::getFactoryPresetName(i));
+        presets.push_back(PresetManager::getFactoryPreset(i));
+    }
+    for (const juce::File &file : sources.files) {
+        Preset preset;
+        if (!parse(file, preset)) continue;
+        const juce::String name = file.getFileNameWithoutExtension();
+        const int factoryIndex = names.indexOf(name);
+        if (factoryIndex >= 0 && factoryIndex < PresetManager::getNumFactoryPresets()) {
+            presets[static_cast<size_t>(factoryIndex)] = preset;
+        } else {
+            names.add(name);
+            presets.push_back(preset);
+        }
+    }
+
+    std::vector<BankName> index;
+    juce::MemoryOutputStream text;
+    for (const juce::String &name : names) {
+        const size_t length = name.getNumBytesAsUTF8();
+        index.push_back({static_cast<uint32_t>(text.getDataSize()), static_cast<uint32_t>(length)});
+        text.write(name.toRawUTF8(), length);
+    }
+
+    BankHeader header = {};
+    std::memcpy(header.magic, BANK_MAGIC, sizeof(BANK_MAGIC));
+    header.layout = bankLayout();
+    header.numPresets = static_cast<uint32_t>(presets.size());
+    header.textSize = static_cast<uint32_t>(text.getDataSize());
+    header.numFiles = static_cast<uint32_t>(sources.files.size());
+    header.filesHash = sources.hash;
+
+    juce::MemoryBlock data;
+    data.append(&header, sizeof(header));
+    data.append(index.data(), index.size() * sizeof(BankName));
+    data.append(presets.data(), presets.size() * sizeof(Preset));
+    data.append(text.getData(), text.getDataSize());
+    return data;
+}
+
+// Readers are brief (a name or one record is copied out), so waiting for the ones that might hold the replaced
+// bank costs the publishing thread next to nothing
+void PresetLibrary::publish(std::unique_ptr<Bank> next) {
+    const juce::ScopedLock lock(publishLock);
+    bank.store(next.get());
+    while (readers.load() != 0) juce::Thread::yield();
+    current = std::move(next); // Frees the replaced bank
+}
+
+void PresetLibrary::write(const juce::File &file, const juce::String &text) {
+    worker.addJob([this, file, text] {
+        file.getParentDirectory().createDirectory();
+        if (file.replaceWithText(text)) {
+            DBG("Saved preset: " << file.getFullPathName());
+        } else {
+            DBG("Failed to save preset: " << file.getFullPathName());
+        }
+        rebuildNow();
+    });
+}
+
+int PresetLibrary::getNumPresets() const {
+    const BankReader reader(*this);
+    return reader.bank != nullptr ? static_cast<int>(reader.bank->header->numPresets) : 0;
+}
+
+juce::String PresetLibrary::getName(int index) const {
+    const BankReader reader(*this);
+    const Bank *held = reader.bank;
+    if (held == nullptr || index < 0 || index >= static_cast<int>(held->header->numPresets)) return {};
+    const BankName &name = held->names[index];
+    return juce::String::fromUTF8(held->text + name.offset, static_cast<int>(name.length));
+}
+
+bool PresetLibrary::getPreset(int index, Preset &preset) const {
+    const BankReader reader(*this);
+    const Bank *held = reader.bank;
+    if (held == nullptr || index < 0 || index >= static_cast<int>(held->header->numPresets)) return false;
+    preset = held->presets[index];
+    return true;
+}
+
+void PresetLibrary::waitUntilIdle() {
+    // The single worker runs jobs in order, so once this marker runs every job queued before it has finished.
+    // Polling getNumJobs() would not do: it can read 0 while a queued job has not started yet.
+    juce::WaitableEvent done;
+    worker.addJob([&done] { done.signal(); });
+    done.wait();
+}
+
+void PresetLibrary::handleAsyncUpdate() {
+    if (onChanged) onChanged();
+}
@@ -0,0 +1,113 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// PresetLibrary.h - The preset bank: one binary file next to the preset directory, memory-mapped read-only. It
+// holds a header, a name index and one fixed-layout record per preset, so opening it is a mapping and two file
+// dates, and a program is an index into the records. A bank holds the factory presets, then the user's; JSON
+// preset files remain the import and export format. The bank is rebuilt from them on a background thread when
+// the preset files have changed since it was built, and after every write. The audio thread reads the current bank
+// without locking or waiting; a replaced bank is freed once no reader can still be using it.
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+#include "SynthEngine.h" // SynthParams and the parameter table
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+class PresetLibrary : private juce::AsyncUpdater {
+    public:
+        // One preset as parameter values in plain units, also its record in the bank file. Only the parameters in
+        // `fields` are set by it.
+        struct Preset {
+                std::array<float, NUM_PARAMETERS> values{};
+                uint32_t fields = 0; // Bit i set when the preset sets parameter i
+
+                SynthParams applyTo(SynthParams params) const; // `params` with this preset's values
+        };
+        static_assert(NUM_PARAMETERS <= 32, "Preset::fields has one bit per parameter");
+        static_assert(std::is_trivially_copyable_v<Preset>, "Presets are read in place from the bank file");
+
+        explicit PresetLibrary(const juce::File &presetDirectory);
+        ~PresetLibrary() override;
+
+        // Read a preset file. Fields the file leaves out take their defaults, fields of the wrong type are left
+        // unset. Returns false if the file is missing or not a preset; a file without a "SimdSynth" object
+        // yields the defaults.
+        static bool parse(const juce::File &file, Preset &preset);
+        static juce::var toJson(const Preset &preset); // The preset as a preset file's JSON
+
+        // Map the bank file, and rebuild it in the background if it is missing, damaged, from another build or
+        // built from other preset files (by name, size and date). Without a preset directory the bank is the
+        // factory presets. Message thread.
+        void open();
+
+        // Rebuild the bank from the factory presets and the directory's JSON files in the background. Message
+        // thread.
+        void rebuild();
+
+        // Write a preset file in the background, then rebuild the bank
+        void write(const juce::File &file, const juce::String &text);
+
+        std::function<void()> onChanged; // Called on the message thread after a rebuilt bank is published
+
+        // The current bank. Any thread; the audio thread never waits here.
+        int getNumPresets() const;
+        juce::String getName(int index) const;           // Empty if out of range
+        bool getPreset(int index, Preset &preset) const; // False if out of range or no bank is loaded yet
+
+        const juce::File &getDirectory() const { return directory; }
+        juce::File getBankFile() const { return directory.getSiblingFile(directory.getFileName() + ".bank"); }
+
+        // Block until the queued rebuilds and writes are done, for offline use
+        void waitUntilIdle();
+
+    private:
+        struct BankHeader;
+        struct BankName;
+        class BankReader;
+
+        // The preset files a bank is built from, in program order, and a hash of their names, sizes and dates
+        struct Sources {
+                juce::Array<juce::File> files;
+                uint64_t hash = 0;
+        };
+
+        // A bank file's bytes, mapped or built in memory, and the sections found in them
+        struct Bank {
+                std::unique_ptr<juce::MemoryMappedFile> mapping; // The bank file, or null for a bank built here
+                juce::MemoryBlock built;                         // The bytes of a bank built here
+                const BankHeader *header = nullptr;              // Null if the bytes are not a valid bank
+                const BankName *names = nullptr;                 // Name index, in program order
+                const Preset *presets = nullptr;                 // Records, in program order
+                const char *text = nullptr;                      // UTF-8 names, indexed by names
+
+                bool attach(const void *data, size_t size); // Check the bytes and find the sections
+        };
+
+        static juce::MemoryBlock buildBank(const Sources &sources);
+        static std::unique_ptr<Bank> compileBank(const Sources &sources);
+        Sources scanSources() const;
+        void rebuildNow(); // Worker thread
+        void publish(std::unique_ptr<Bank> next);
+        void handleAsyncUpdate() override;
+
+        const juce::File directory;
+        std::atomic<const Bank *> bank{nullptr}; // Current bank, read by the audio thread
+        std::unique_ptr<Bank> current;           // Owns the current bank, guarded by publishLock
+        mutable std::atomic<int> readers{0};     // Threads reading a bank through a BankReader
+        juce::CriticalSection publishLock;       // Serializes publish
+        juce::ThreadPool worker{1};               // Runs rebuilds and writes in order
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetLibrary)
+};
@@ -1,7 +1,7 @@
 /*
  * simdsynth - a playground for experimenting with SIMD-based audio
  *             synthesis, with polyphonic main and sub-oscillator,
- *             filter, envelopes, and LFO per voice, up to 16 voices.
+ *             filter, envelopes, and LFO per voice, with configurable polyphony.
  *
  * MIT Licensed, (c) 2025, seclorum
  */
@@ -9,19 +9,24 @@
 #ifndef SIMDSYNTH_PRESETMANAGER_H
 #define SIMDSYNTH_PRESETMANAGER_H
 
-// PresetManager.h
+// PresetManager.h - The factory presets, compiled into the plugin as preset records, and the preset directory.
+// Factory presets come first in every preset bank and need no files; they are only written out as JSON on
+// request, to edit or to hand to the render tool.
 #pragma once
 
 #include <juce_core/juce_core.h>
+#include "PresetLibrary.h" // Preset records
 
 class PresetManager {
     public:
-        PresetManager();
-        void createDefaultPresets();
-        void writePresetFile(const juce::String &presetName, const juce::var &parameters);
+        static int getNumFactoryPresets();
+        static const char *getFactoryPresetName(int index);
+        static const PresetLibrary::Preset &getFactoryPreset(int index);
 
-    private:
-        juce::File getPresetDirectory();
+        // Write the factory presets that are missing from the preset directory as JSON files
+        static void writeFactoryPresets();
+
+        static juce::File getPresetDirectory();
 };
 
 #endif // SIMDSYNTH_PRESETMANAGER_H
@@ -0,0 +1,64 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+#include "Profiler.h"
+
+#if SIMDSYNTH_PROFILING
+#include <algorithm>
+#include <chrono>
+
+double profileTicksPerSecond() {
+    static const double ticksPerSecond = [] {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+        // The time-stamp counter runs at a fixed rate on current CPUs; count it against the steady clock
+        using Clock = std::chrono::steady_clock;
+        const Clock::time_point begin = Clock::now();
+        const uint64_t beginTicks = profileClock();
+        Clock::time_point end = begin;
+        while (end - begin < std::chrono::milliseconds(5)) end = Clock::now();
+        const uint64_t endTicks = profileClock();
+        return static_cast<double>(endTicks - beginTicks) / std::chrono::duration<double>(end - begin).count();
+#elif defined(__aarch64__) && !defined(_MSC_VER)
+        uint64_t frequency;
+        asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+        return static_cast<double>(frequency);
+#else
+        return static_cast<double>(std::chrono::steady_clock::period::den) / std::chrono::steady_clock::period::num;
+#endif
+    }();
+    return ticksPerSecond;
+}
+
+Profiler::Profiler() { reset(sampleRate); }
+
+void Profiler::reset(double hostSampleRate) {
+    sampleRate = hostSampleRate;
+    counters = {};
+    totals = {};
+    totals.ticksPerSecond = profileTicksPerSecond();
+    snapshots.write(totals);
+}
+
+void Profiler::endBlock(int numSamples, int activeVoices) {
+    const uint64_t blockTicks = profileClock() - blockStart;
+    for (int s = 0; s < NUM_PROFILE_STAGES; ++s) totals.stageTicks[s] += counters.ticks[s];
+    counters = {};
+
+    const double deadline = numSamples / sampleRate;
+    const double blockSeconds = totals.seconds(blockTicks);
+    totals.blockTicks += blockTicks;
+    totals.blocks++;
+    totals.audioSeconds += deadline;
+    totals.lastDeadlinePercent = deadline > 0.0 ? 100.0 * blockSeconds / deadline : 0.0;
+    totals.worstDeadlinePercent = std::max(totals.worstDeadlinePercent, totals.lastDeadlinePercent);
+    totals.worstBlockSeconds = std::max(totals.worstBlockSeconds, blockSeconds);
+    totals.activeVoices = activeVoices;
+    totals.peakVoices = std::max(totals.peakVoices, activeVoices);
+    snapshots.write(totals);
+}
+#endif
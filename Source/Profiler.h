@@ -0,0 +1,153 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// Profiler.h - Audio-thread timing. Stage timers read the CPU's cycle counter around the stages of a block and
+// add the ticks to per-thread counters; after each block the totals go out as a wait-free snapshot for the editor,
+// simdsynth-render and simdsynth-bench. Built in with -DSIMDSYNTH_PROFILING=ON; otherwise every timer and counter
+// compiles to nothing and only the snapshot type remains, so readers build either way.
+#pragma once
+
+#include <cstdint>
+
+#ifndef SIMDSYNTH_PROFILING
+#define SIMDSYNTH_PROFILING 0
+#endif
+
+#if SIMDSYNTH_PROFILING
+#include "TripleBuffer.h"
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#elif !defined(__aarch64__) || defined(_MSC_VER)
+#include <chrono>
+#endif
+#define SIMDSYNTH_PROFILE_ONLY(...) __VA_ARGS__ // Code that only exists in profiling builds
+#else
+#define SIMDSYNTH_PROFILE_ONLY(...)
+#endif
+
+// The timed stages of a block
+enum ProfileStage : int {
+    StageMidi,           // MIDI messages to engine events, and applying them to the voices
+    StageParameters,     // Parameter snapshot, smoothing and the per-voice values derived from it
+    StageEnvelopes,      // Envelopes, LFOs and filter coefficients, at control rate
+    StageOscillators,    // Per-lane setup and the oscillators
+    StageFilter,         // Ladder filter, DC blocker, saturation and pan into the batch accumulators
+    StageOutput,         // Voice bookkeeping, then the batch mix with gain and voice scaling
+    StageOversampleUp,   // Oversampler, up
+    StageOversampleDown, // Oversampler, down
+    NUM_PROFILE_STAGES
+};
+
+static constexpr const char *PROFILE_STAGE_NAMES[NUM_PROFILE_STAGES] = {
+    "midi", "parameters", "envelopes", "oscillators", "filter", "output", "oversample_up", "oversample_down"};
+
+// Totals since the profiler was last reset, published after every block. A reader wanting figures over its own
+// interval keeps the previous snapshot and takes the difference.
+struct ProfileSnapshot {
+        uint64_t stageTicks[NUM_PROFILE_STAGES] = {}; // Ticks in each stage; batch stages add up over all threads
+        uint64_t blockTicks = 0;                      // Ticks in whole blocks, wall clock
+        uint64_t blocks = 0;                          // Blocks timed
+        double audioSeconds = 0.0;                    // Audio those blocks produced, their combined deadline
+        double ticksPerSecond = 1.0e9;                // Clock rate
+        double lastDeadlinePercent = 0.0;             // Share of its deadline the last block took
+        double worstDeadlinePercent = 0.0;            // Highest share any block took
+        double worstBlockSeconds = 0.0;               // Longest block
+        int activeVoices = 0;                         // Voices sounding after the last block
+        int peakVoices = 0;                           // Most voices sounding after any block
+
+        double seconds(uint64_t ticks) const { return static_cast<double>(ticks) / ticksPerSecond; }
+        double meanDeadlinePercent() const {
+            return audioSeconds > 0.0 ? 100.0 * seconds(blockTicks) / audioSeconds : 0.0;
+        }
+};
+
+#if SIMDSYNTH_PROFILING
+// Cycle counter: the time-stamp counter on x86, the virtual counter on ARM64, nanoseconds elsewhere. Static, so
+// each voice kernel build keeps its own copy.
+static inline uint64_t profileClock() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    return __rdtsc();
+#elif defined(__aarch64__) && !defined(_MSC_VER)
+    uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// Ticks of profileClock per second. The first call measures the x86 counter for a few milliseconds, so make it
+// off the audio thread; Profiler's constructor does.
+double profileTicksPerSecond();
+
+// Ticks per stage, added up by the one thread that owns them
+struct ProfileCounters {
+        uint64_t ticks[NUM_PROFILE_STAGES] = {};
+
+        // Move another thread's ticks into these, once that thread is done with them
+        void take(ProfileCounters &other) {
+            for (int s = 0; s < NUM_PROFILE_STAGES; ++s) ticks[s] += other.ticks[s];
+            other = {};
+        }
+};
+
+// Charges the time from construction, or from the last next(), to the current stage. With null counters it
+// reads no clock at all.
+class StageTimer {
+    public:
+        StageTimer(ProfileCounters *counters, ProfileStage stage)
+            : counters(counters), stage(stage), start(counters != nullptr ? profileClock() : 0) {}
+        ~StageTimer() { stop(); }
+        StageTimer(const StageTimer &) = delete;
+        StageTimer &operator=(const StageTimer &) = delete;
+
+        // Time `nextStage` from here on
+        void next(ProfileStage nextStage) {
+            if (counters == nullptr || (stage == NUM_PROFILE_STAGES && nextStage == NUM_PROFILE_STAGES)) return;
+            const uint64_t now = profileClock();
+            if (stage != NUM_PROFILE_STAGES) counters->ticks[stage] += now - start;
+            stage = nextStage;
+            start = now;
+        }
+
+        void stop() { next(NUM_PROFILE_STAGES); } // Time nothing until the next next()
+
+    private:
+        ProfileCounters *counters;
+        ProfileStage stage; // NUM_PROFILE_STAGES while stopped
+        uint64_t start;
+};
+
+// The block timings of one audio thread. The audio thread calls beginBlock, times its stages into getCounters()
+// and calls endBlock; one reader thread takes the snapshots.
+class Profiler {
+    public:
+        Profiler();
+
+        // Start over from zero, for a new sample rate. Not while blocks are running.
+        void reset(double hostSampleRate);
+
+        void beginBlock() { blockStart = profileClock(); }
+        ProfileCounters *getCounters() { return &counters; }
+        void endBlock(int numSamples, int activeVoices); // Host samples in the block, voices sounding after it
+
+        // The totals as of the latest block, if there is one the reader has not seen
+        bool read(ProfileSnapshot &snapshot) { return snapshots.read(snapshot); }
+
+    private:
+        ProfileCounters counters;                // The current block's stages
+        ProfileSnapshot totals;                  // Audio thread's running totals
+        TripleBuffer<ProfileSnapshot> snapshots; // Totals handed to the reader
+        uint64_t blockStart = 0;
+        double sampleRate = 44100.0;
+};
+#endif
@@ -0,0 +1,120 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// SimdMath.h - The transcendental functions shared by all kernels. They are templates over any
+// simd::Vec (see SimdVec.h), so every backend shares one implementation. Error bounds below were
+// measured against libm (double precision) over the stated domains.
+#pragma once
+
+#include "SimdVec.h"
+
+namespace simdmath {
+
+constexpr float pi = 3.14159265358979323846f;
+constexpr float twoPi = 2.0f * pi;
+constexpr float log2e = 1.44269504088896340736f;
+
+// Sine, any argument. Wrapped to [-pi, pi) and folded into [-pi/2, pi/2] with sin(x) = sin(pi - x)
+// before an odd polynomial. Max abs error 4e-6 for |x| <= 10, 1e-5 for |x| < 100; the float range
+// reduction loses accuracy beyond that, so keep phases wrapped.
+template <typename V>
+inline V sin_ps(V x) {
+    const V q = simd::floor(simd::fmadd(x, V::set1(1.0f / twoPi), V::set1(0.5f)));
+    x = x - q * V::set1(twoPi);
+    const V signedPi = simd::select(x < V::set1(0.0f), V::set1(-pi), V::set1(pi));
+    x = simd::select(simd::abs(x) > V::set1(pi / 2.0f), signedPi - x, x);
+    const V x2 = x * x;
+    V p = simd::fmadd(x2, V::set1(1.0f / 362880.0f), V::set1(-1.0f / 5040.0f));
+    p = simd::fmadd(x2, p, V::set1(1.0f / 120.0f));
+    p = simd::fmadd(x2, p, V::set1(-1.0f / 6.0f));
+    return simd::fmadd(x2 * x, p, x);
+}
+
+// Cosine, same bounds as sin_ps
+template <typename V>
+inline V cos_ps(V x) {
+    return sin_ps(x + V::set1(pi / 2.0f));
+}
+
+// 2^x, clamped to x in [-126, 126]. Rounds to the nearest integer and evaluates 2^f on [-0.5, 0.5]
+// with a degree 6 polynomial. Max relative error 2.5e-7.
+template <typename V>
+inline V exp2_ps(V x) {
+    x = simd::max(V::set1(-126.0f), simd::min(x, V::set1(126.0f)));
+    const V n = simd::floor(x + V::set1(0.5f));
+    const V f = (x - n) * V::set1(0.69314718056f); // f * ln 2
+    V p = simd::fmadd(f, V::set1(1.0f / 720.0f), V::set1(1.0f / 120.0f));
+    p = simd::fmadd(f, p, V::set1(1.0f / 24.0f));
+    p = simd::fmadd(f, p, V::set1(1.0f / 6.0f));
+    p = simd::fmadd(f, p, V::set1(0.5f));
+    p = simd::fmadd(f, p, V::set1(1.0f));
+    p = simd::fmadd(f, p, V::set1(1.0f));
+    return p * simd::pow2i(n);
+}
+
+// e^x, clamped to x in [-87, 87]. Max relative error 7e-7 for |x| < 10, 4e-6 at the range ends.
+template <typename V>
+inline V exp_ps(V x) {
+    return exp2_ps(x * V::set1(log2e));
+}
+
+// Tangent for the ladder prewarp, |x| <= 1.45 (cutoffs up to 0.46 of the sample rate). Evaluates
+// tan(x / 2) with an odd polynomial and doubles the angle. Max relative error 7e-7 for |x| <= 1.2,
+// 3e-5 at 1.45.
+template <typename V>
+inline V tan_ps(V x) {
+    const V y = x * V::set1(0.5f);
+    const V y2 = y * y;
+    V p = simd::fmadd(y2, V::set1(929569.0f / 638512875.0f), V::set1(21844.0f / 6081075.0f));
+    p = simd::fmadd(y2, p, V::set1(1382.0f / 155925.0f));
+    p = simd::fmadd(y2, p, V::set1(62.0f / 2835.0f));
+    p = simd::fmadd(y2, p, V::set1(17.0f / 315.0f));
+    p = simd::fmadd(y2, p, V::set1(2.0f / 15.0f));
+    p = simd::fmadd(y2, p, V::set1(1.0f / 3.0f));
+    const V t = simd::fmadd(y2 * y, p, y);
+    return (t + t) / (V::set1(1.0f) - t * t);
+}
+
+// Hyperbolic tangent, any argument, via (e^2x - 1) / (e^2x + 1). Max abs error 1.5e-7.
+template <typename V>
+inline V tanh_ps(V x) {
+    x = simd::max(V::set1(-9.0f), simd::min(x, V::set1(9.0f)));
+    const V e = exp2_ps(x * V::set1(2.0f * log2e));
+    return (e - V::set1(1.0f)) / (e + V::set1(1.0f));
+}
+
+// Cubic soft clip x - x^3 / 3 after clamping to [-1, 1]; exact, saturates at +-2/3
+template <typename V>
+inline V softclip_ps(V x) {
+    x = simd::max(V::set1(-1.0f), simd::min(x, V::set1(1.0f)));
+    return x - x * x * x * V::set1(1.0f / 3.0f);
+}
+
+// Frequency ratio for a pitch offset in semitones, 2^(x / 12). Max relative error 4e-7 within four
+// octaves, 7e-7 over the MIDI range.
+template <typename V>
+inline V semitonesToRatio_ps(V semitones) {
+    return exp2_ps(semitones * V::set1(1.0f / 12.0f));
+}
+
+// Horizontal sum and first lane of a vector
+template <typename V>
+inline float sum(V x) {
+    return simd::sum(x);
+}
+
+template <typename V>
+inline float first(V x) {
+    return simd::first(x);
+}
+
+// Scalar forms for per-note and per-parameter use
+inline float semitonesToRatio(float semitones) { return semitonesToRatio_ps(simd::Vec<simd::Scalar>{semitones}).v; }
+inline float exp(float x) { return exp_ps(simd::Vec<simd::Scalar>{x}).v; }
+
+} // namespace simdmath
@@ -0,0 +1,202 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// SimdVec.h - Width-generic float vector. simd::Vec<Isa> wraps one native register per backend
+// (SSE4.1, AVX2/FMA, AVX-512, NEON, scalar) behind the same set of free functions, so kernels
+// written against it compile unchanged at 1, 4, 8 or 16 lanes. A backend is only defined when the
+// compiler flags of the including translation unit enable its instruction set.
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(__arm64__)
+#include <arm_neon.h>
+#endif
+
+namespace simd {
+
+struct Scalar {};
+struct Sse41 {};
+struct Avx2 {};
+struct Avx512 {};
+struct Neon {};
+
+template <typename Isa>
+struct Vec;
+
+// Scalar fallback: one lane, plain float math
+template <>
+struct Vec<Scalar> {
+        using Mask = bool;
+        static constexpr int width = 1;
+        float v;
+
+        static Vec set1(float x) { return {x}; }
+        static Vec load(const float *p) { return {*p}; }
+        void store(float *p) const { *p = v; }
+};
+
+inline Vec<Scalar> operator+(Vec<Scalar> a, Vec<Scalar> b) { return {a.v + b.v}; }
+inline Vec<Scalar> operator-(Vec<Scalar> a, Vec<Scalar> b) { return {a.v - b.v}; }
+inline Vec<Scalar> operator*(Vec<Scalar> a, Vec<Scalar> b) { return {a.v * b.v}; }
+inline Vec<Scalar> operator/(Vec<Scalar> a, Vec<Scalar> b) { return {a.v / b.v}; }
+inline bool operator<(Vec<Scalar> a, Vec<Scalar> b) { return a.v < b.v; }
+inline bool operator>(Vec<Scalar> a, Vec<Scalar> b) { return a.v > b.v; }
+inline Vec<Scalar> min(Vec<Scalar> a, Vec<Scalar> b) { return {b.v < a.v ? b.v : a.v}; }
+inline Vec<Scalar> max(Vec<Scalar> a, Vec<Scalar> b) { return {a.v < b.v ? b.v : a.v}; }
+inline Vec<Scalar> fmadd(Vec<Scalar> a, Vec<Scalar> b, Vec<Scalar> c) { return {a.v * b.v + c.v}; }
+inline Vec<Scalar> floor(Vec<Scalar> a) { return {std::floor(a.v)}; }
+inline Vec<Scalar> abs(Vec<Scalar> a) { return {std::fabs(a.v)}; }
+inline Vec<Scalar> select(bool m, Vec<Scalar> a, Vec<Scalar> b) { return m ? a : b; }
+inline Vec<Scalar> pow2i(Vec<Scalar> n) { return {std::ldexp(1.0f, static_cast<int>(n.v))}; }
+inline float first(Vec<Scalar> a) { return a.v; }
+inline float sum(Vec<Scalar> a) { return a.v; }
+
+#if defined(__SSE4_1__)
+// SSE4.1: four lanes
+template <>
+struct Vec<Sse41> {
+        using Mask = __m128;
+        static constexpr int width = 4;
+        __m128 v;
+
+        static Vec set1(float x) { return {_mm_set1_ps(x)}; }
+        static Vec load(const float *p) { return {_mm_load_ps(p)}; }
+        void store(float *p) const { _mm_store_ps(p, v); }
+};
+
+inline Vec<Sse41> operator+(Vec<Sse41> a, Vec<Sse41> b) { return {_mm_add_ps(a.v, b.v)}; }
+inline Vec<Sse41> operator-(Vec<Sse41> a, Vec<Sse41> b) { return {_mm_sub_ps(a.v, b.v)}; }
+inline Vec<Sse41> operator*(Vec<Sse41> a, Vec<Sse41> b) { return {_mm_mul_ps(a.v, b.v)}; }
+inline Vec<Sse41> operator/(Vec<Sse41> a, Vec<Sse41> b) { return {_mm_div_ps(a.v, b.v)}; }
+inline __m128 operator<(Vec<Sse41> a, Vec<Sse41> b) { return _mm_cmplt_ps(a.v, b.v); }
+inline __m128 operator>(Vec<Sse41> a, Vec<Sse41> b) { return _mm_cmpgt_ps(a.v, b.v); }
+inline Vec<Sse41> min(Vec<Sse41> a, Vec<Sse41> b) { return {_mm_min_ps(a.v, b.v)}; }
+inline Vec<Sse41> max(Vec<Sse41> a, Vec<Sse41> b) { return {_mm_max_ps(a.v, b.v)}; }
+inline Vec<Sse41> fmadd(Vec<Sse41> a, Vec<Sse41> b, Vec<Sse41> c) { return {_mm_add_ps(_mm_mul_ps(a.v, b.v), c.v)}; }
+inline Vec<Sse41> floor(Vec<Sse41> a) { return {_mm_floor_ps(a.v)}; }
+inline Vec<Sse41> abs(Vec<Sse41> a) { return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)}; }
+inline Vec<Sse41> select(__m128 m, Vec<Sse41> a, Vec<Sse41> b) { return {_mm_blendv_ps(b.v, a.v, m)}; }
+inline Vec<Sse41> pow2i(Vec<Sse41> n) {
+    return {_mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvtps_epi32(n.v), _mm_set1_epi32(127)), 23))};
+}
+inline float first(Vec<Sse41> a) { return _mm_cvtss_f32(a.v); }
+inline float sum(Vec<Sse41> a) {
+    __m128 pairs = _mm_add_ps(a.v, _mm_movehl_ps(a.v, a.v));
+    return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+}
+#endif
+
+#if defined(__AVX2__) && defined(__FMA__)
+// AVX2 with FMA: eight lanes
+template <>
+struct Vec<Avx2> {
+        using Mask = __m256;
+        static constexpr int width = 8;
+        __m256 v;
+
+        static Vec set1(float x) { return {_mm256_set1_ps(x)}; }
+        static Vec load(const float *p) { return {_mm256_load_ps(p)}; }
+        void store(float *p) const { _mm256_store_ps(p, v); }
+};
+
+inline Vec<Avx2> operator+(Vec<Avx2> a, Vec<Avx2> b) { return {_mm256_add_ps(a.v, b.v)}; }
+inline Vec<Avx2> operator-(Vec<Avx2> a, Vec<Avx2> b) { return {_mm256_sub_ps(a.v, b.v)}; }
+inline Vec<Avx2> operator*(Vec<Avx2> a, Vec<Avx2> b) { return {_mm256_mul_ps(a.v, b.v)}; }
+inline Vec<Avx2> operator/(Vec<Avx2> a, Vec<Avx2> b) { return {_mm256_div_ps(a.v, b.v)}; }
+inline __m256 operator<(Vec<Avx2> a, Vec<Avx2> b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ); }
+inline __m256 operator>(Vec<Avx2> a, Vec<Avx2> b) { return _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ); }
+inline Vec<Avx2> min(Vec<Avx2> a, Vec<Avx2> b) { return {_mm256_min_ps(a.v, b.v)}; }
+inline Vec<Avx2> max(Vec<Avx2> a, Vec<Avx2> b) { return {_mm256_max_ps(a.v, b.v)}; }
+inline Vec<Avx2> fmadd(Vec<Avx2> a, Vec<Avx2> b, Vec<Avx2> c) { return {_mm256_fmadd_ps(a.v, b.v, c.v)}; }
+inline Vec<Avx2> floor(Vec<Avx2> a) { return {_mm256_floor_ps(a.v)}; }
+inline Vec<Avx2> abs(Vec<Avx2> a) { return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)}; }
+inline Vec<Avx2> select(__m256 m, Vec<Avx2> a, Vec<Avx2> b) { return {_mm256_blendv_ps(b.v, a.v, m)}; }
+inline Vec<Avx2> pow2i(Vec<Avx2> n) {
+    return {_mm256_castsi256_ps(
+        _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n.v), _mm256_set1_epi32(127)), 23))};
+}
+inline float first(Vec<Avx2> a) { return _mm256_cvtss_f32(a.v); }
+inline float sum(Vec<Avx2> a) {
+    __m128 quad = _mm_add_ps(_mm256_castps256_ps128(a.v), _mm256_extractf128_ps(a.v, 1));
+    __m128 pairs = _mm_add_ps(quad, _mm_movehl_ps(quad, quad));
+    return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+}
+#endif
+
+#if defined(__AVX512F__)
+// AVX-512: sixteen lanes, a whole 16-voice bank per register
+template <>
+struct Vec<Avx512> {
+        using Mask = __mmask16;
+        static constexpr int width = 16;
+        __m512 v;
+
+        static Vec set1(float x) { return {_mm512_set1_ps(x)}; }
+        static Vec load(const float *p) { return {_mm512_load_ps(p)}; }
+        void store(float *p) const { _mm512_store_ps(p, v); }
+};
+
+inline Vec<Avx512> operator+(Vec<Avx512> a, Vec<Avx512> b) { return {_mm512_add_ps(a.v, b.v)}; }
+inline Vec<Avx512> operator-(Vec<Avx512> a, Vec<Avx512> b) { return {_mm512_sub_ps(a.v, b.v)}; }
+inline Vec<Avx512> operator*(Vec<Avx512> a, Vec<Avx512> b) { return {_mm512_mul_ps(a.v, b.v)}; }
+inline Vec<Avx512> operator/(Vec<Avx512> a, Vec<Avx512> b) { return {_mm512_div_ps(a.v, b.v)}; }
+inline __mmask16 operator<(Vec<Avx512> a, Vec<Avx512> b) { return _mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ); }
+inline __mmask16 operator>(Vec<Avx512> a, Vec<Avx512> b) { return _mm512_cmp_ps_mask(a.v, b.v, _CMP_GT_OQ); }
+inline Vec<Avx512> min(Vec<Avx512> a, Vec<Avx512> b) { return {_mm512_min_ps(a.v, b.v)}; }
+inline Vec<Avx512> max(Vec<Avx512> a, Vec<Avx512> b) { return {_mm512_max_ps(a.v, b.v)}; }
+inline Vec<Avx512> fmadd(Vec<Avx512> a, Vec<Avx512> b, Vec<Avx512> c) { return {_mm512_fmadd_ps(a.v, b.v, c.v)}; }
+inline Vec<Avx512> floor(Vec<Avx512> a) {
+    return {_mm512_roundscale_ps(a.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)};
+}
+inline Vec<Avx512> abs(Vec<Avx512> a) { return {_mm512_abs_ps(a.v)}; }
+inline Vec<Avx512> select(__mmask16 m, Vec<Avx512> a, Vec<Avx512> b) { return {_mm512_mask_blend_ps(m, b.v, a.v)}; }
+inline Vec<Avx512> pow2i(Vec<Avx512> n) {
+    return {_mm512_castsi512_ps(
+        _mm512_slli_epi32(_mm512_add_epi32(_mm512_cvtps_epi32(n.v), _mm512_set1_epi32(127)), 23))};
+}
+inline float first(Vec<Avx512> a) { return _mm512_cvtss_f32(a.v); }
+inline float sum(Vec<Avx512> a) { return _mm512_reduce_add_ps(a.v); }
+#endif
+
+#if defined(__aarch64__) || defined(__arm64__)
+// NEON: four lanes
+template <>
+struct Vec<Neon> {
+        using Mask = uint32x4_t;
+        static constexpr int width = 4;
+        float32x4_t v;
+
+        static Vec set1(float x) { return {vdupq_n_f32(x)}; }
+        static Vec load(const float *p) { return {vld1q_f32(p)}; }
+        void store(float *p) const { vst1q_f32(p, v); }
+};
+
+inline Vec<Neon> operator+(Vec<Neon> a, Vec<Neon> b) { return {vaddq_f32(a.v, b.v)}; }
+inline Vec<Neon> operator-(Vec<Neon> a, Vec<Neon> b) { return {vsubq_f32(a.v, b.v)}; }
+inline Vec<Neon> operator*(Vec<Neon> a, Vec<Neon> b) { return {vmulq_f32(a.v, b.v)}; }
+inline Vec<Neon> operator/(Vec<Neon> a, Vec<Neon> b) { return {vdivq_f32(a.v, b.v)}; }
+inline uint32x4_t operator<(Vec<Neon> a, Vec<Neon> b) { return vcltq_f32(a.v, b.v); }
+inline uint32x4_t operator>(Vec<Neon> a, Vec<Neon> b) { return vcgtq_f32(a.v, b.v); }
+inline Vec<Neon> min(Vec<Neon> a, Vec<Neon> b) { return {vminq_f32(a.v, b.v)}; }
+inline Vec<Neon> max(Vec<Neon> a, Vec<Neon> b) { return {vmaxq_f32(a.v, b.v)}; }
+inline Vec<Neon> fmadd(Vec<Neon> a, Vec<Neon> b, Vec<Neon> c) { return {vfmaq_f32(c.v, a.v, b.v)}; }
+inline Vec<Neon> floor(Vec<Neon> a) { return {vrndmq_f32(a.v)}; }
+inline Vec<Neon> abs(Vec<Neon> a) { return {vabsq_f32(a.v)}; }
+inline Vec<Neon> select(uint32x4_t m, Vec<Neon> a, Vec<Neon> b) { return {vbslq_f32(m, a.v, b.v)}; }
+inline Vec<Neon> pow2i(Vec<Neon> n) {
+    return {vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(vcvtq_s32_f32(n.v), vdupq_n_s32(127)), 23))};
+}
+inline float first(Vec<Neon> a) { return vgetq_lane_f32(a.v, 0); }
+inline float sum(Vec<Neon> a) { return vaddvq_f32(a.v); }
+#endif
+
+} // namespace simd
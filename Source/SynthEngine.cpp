@@ -0,0 +1,797 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+#include "SynthEngine.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+// Flush denormals to zero for the lifetime of the object (FTZ and DAZ on x86, FZ on AArch64)
+struct ScopedFlushDenormals {
+#if defined(__x86_64__) || defined(_M_X64)
+        ScopedFlushDenormals() : saved(_mm_getcsr()) { _mm_setcsr(saved | 0x8040); }
+        ~ScopedFlushDenormals() { _mm_setcsr(saved); }
+        unsigned int saved;
+#elif defined(__aarch64__)
+        ScopedFlushDenormals() {
+            asm volatile("mrs %0, fpcr" : "=r"(saved));
+            asm volatile("msr fpcr, %0" : : "r"(saved | (1ull << 24)));
+        }
+        ~ScopedFlushDenormals() { asm volatile("msr fpcr, %0" : : "r"(saved)); }
+        uint64_t saved;
+#endif
+};
+
+SynthEngine::SynthEngine(uint32_t seed) : random(seed) {
+    // Tables for the default rate until prepare picks the host's
+    wavetables = Wavetables::acquire(44100.0);
+
+    // Initialize voices with default parameter values
+    setParameters(params, true);
+    for (int i = 0; i < MAX_VOICE_POLYPHONY; ++i) {
+        VoiceParams &vp = voices.params[i];
+        voices.setActive(i, false);
+        voices.released[i] = false;
+        vp.unison = std::clamp(params.unison, 1, maxUnison);
+        vp.detune = params.detune;
+        for (int u = 0; u < maxUnison; ++u) {
+            vp.unisonPhases[u] = nextRandom() * 0.01f; // Initialize once
+            float detuneCents = vp.detune * (u - (vp.unison - 1) / 2.0f) / (vp.unison - 1 + 0.0001f);
+            vp.detuneFactors[u] = simdmath::semitonesToRatio(detuneCents);
+        }
+
+        voices.smoothedCutoff[i].setCurrentAndTargetValue(params.cutoff);
+        voices.smoothedFegAmount[i].setCurrentAndTargetValue(params.fegAmount);
+        voices.clearState(i);
+    }
+    updateVoiceParameters(getSampleRate(), GroupAll, true);
+    batchOutputs.resize(static_cast<size_t>((MAX_VOICE_POLYPHONY + kernels.width - 1) / kernels.width));
+}
+
+// Build the tables for the host rate and reset every voice and smoother
+void SynthEngine::prepare(double hostSampleRate, int oversamplingFactor) {
+    filter.sampleRate = static_cast<float>(hostSampleRate);
+    osFactor = oversamplingFactor;
+    sampleClock = 0;
+    envelopeSamplesPending = 0;
+    sustainPedal = false;
+    if (wavetables->getSampleRate() != hostSampleRate) wavetables = Wavetables::acquire(hostSampleRate);
+
+    // Initialize smoothed parameters with actual sample rate
+    for (int p = 0; p < NUM_PARAMETERS; ++p) {
+        if (LinearSmoother *smoother = smootherFor(p)) smoother->reset(hostSampleRate, PARAMETERS[p].smoothingSeconds);
+    }
+
+    // Reset voices
+    for (int i = 0; i < MAX_VOICE_POLYPHONY; ++i) {
+        voices.setActive(i, false);
+        voices.released[i] = false;
+        voices.sustained[i] = false;
+        voices.velocity[i] = 0.0f;
+        voices.noteOnSample[i] = 0;
+        voices.ampEnv.hold(i, EnvelopeStage::Idle, 0.0f);
+        voices.filterEnv.hold(i, EnvelopeStage::Idle, 0.0f);
+        voices.params[i].lfoPitchAmt = params.lfoPitchAmt;
+        voices.clearState(i);
+
+        voices.smoothedCutoff[i].reset(getSampleRate(), PARAMETERS[ParamCutoff].smoothingSeconds);
+        voices.smoothedFegAmount[i].reset(getSampleRate(), PARAMETERS[ParamFegAmount].smoothingSeconds);
+    }
+
+    updateVoiceParameters(getSampleRate(), GroupAll, true);
+}
+
+// Switch the engine rate between oversampling factors. Nothing is allocated here; envelope segments,
+// smoothers and phase increments are rescaled for the new rate.
+void SynthEngine::setOversamplingFactor(int factor) {
+    if (factor == osFactor) return;
+    const double tickRatio = static_cast<double>(factor) / osFactor;
+    osFactor = factor;
+
+    const float sampleRate = getSampleRate();
+    for (int i = 0; i < MAX_VOICE_POLYPHONY; ++i) {
+        voices.ampEnv.rescale(i, tickRatio);
+        voices.filterEnv.rescale(i, tickRatio);
+        voices.smoothedCutoff[i].reset(sampleRate, PARAMETERS[ParamCutoff].smoothingSeconds);
+        voices.smoothedFegAmount[i].reset(sampleRate, PARAMETERS[ParamFegAmount].smoothingSeconds);
+    }
+    updateVoiceParameters(sampleRate, GroupAll, true);
+}
+
+// Take new parameter values. Smoothed parameters ramp to them (or jump, for preset loads). The new values
+// are compared with the current ones field by field, and only the per-voice values derived from the fields
+// that changed are refreshed at the start of the next render.
+void SynthEngine::setParameters(const SynthParams &newParams, bool jump) {
+    unsigned changed = 0;
+    for (int p = 0; p < NUM_PARAMETERS; ++p) {
+        const float value = getParameterValue(newParams, p);
+        if (value != getParameterValue(params, p)) changed |= PARAMETERS[p].voiceGroups;
+        if (LinearSmoother *smoother = smootherFor(p)) {
+            if (jump) {
+                smoother->setCurrentAndTargetValue(value);
+            } else {
+                smoother->setTargetValue(value);
+            }
+        }
+    }
+    params = newParams;
+    filter.resonance = params.resonance;
+    dirtyGroups |= changed;
+}
+
+// The smoother that carries a parameter engine-wide. Cutoff and filter envelope amount are smoothed per voice
+// instead, and the remaining parameters apply at once.
+LinearSmoother *SynthEngine::smootherFor(int index) {
+    switch (index) {
+    case ParamAttackCurve: return &smoothedAttackCurve;
+    case ParamReleaseCurve: return &smoothedReleaseCurve;
+    case ParamResonance: return &smoothedResonance;
+    case ParamFilterMix: return &smoothedFilterMix;
+    case ParamLfoRate: return &smoothedLfoRate;
+    case ParamLfoDepth: return &smoothedLfoDepth;
+    case ParamSubTune: return &smoothedSubTune;
+    case ParamSubMix: return &smoothedSubMix;
+    case ParamSubTrack: return &smoothedSubTrack;
+    case ParamOsc2Tune: return &smoothedOsc2Tune;
+    case ParamOsc2Mix: return &smoothedOsc2Mix;
+    case ParamOsc2Track: return &smoothedOsc2Track;
+    case ParamGain: return &smoothedGain;
+    case ParamDetune: return &smoothedDetune;
+    default: return nullptr;
+    }
+}
+
+float getParameterValue(const SynthParams &params, int index) {
+    switch (index) {
+    case ParamWavetable: return static_cast<float>(params.wavetable);
+    case ParamAttack: return params.attack;
+    case ParamDecay: return params.decay;
+    case ParamSustain: return params.sustain;
+    case ParamRelease: return params.release;
+    case ParamAttackCurve: return params.attackCurve;
+    case ParamReleaseCurve: return params.releaseCurve;
+    case ParamFilterBypass: return params.filterBypass ? 1.0f : 0.0f;
+    case ParamCutoff: return params.cutoff;
+    case ParamResonance: return params.resonance;
+    case ParamFegAttack: return params.fegAttack;
+    case ParamFegDecay: return params.fegDecay;
+    case ParamFegSustain: return params.fegSustain;
+    case ParamFegRelease: return params.fegRelease;
+    case ParamFegAmount: return params.fegAmount;
+    case ParamFilterMix: return params.filterMix;
+    case ParamLfoRate: return params.lfoRate;
+    case ParamLfoDepth: return params.lfoDepth;
+    case ParamLfoPitchAmt: return params.lfoPitchAmt;
+    case ParamSubTune: return params.subTune;
+    case ParamSubMix: return params.subMix;
+    case ParamSubTrack: return params.subTrack;
+    case ParamOsc2Tune: return params.osc2Tune;
+    case ParamOsc2Mix: return params.osc2Mix;
+    case ParamOsc2Track: return params.osc2Track;
+    case ParamGain: return params.gain;
+    case ParamUnison: return static_cast<float>(params.unison);
+    case ParamDetune: return params.detune;
+    default: return 0.0f;
+    }
+}
+
+void setParameterValue(SynthParams &params, int index, float value) {
+    switch (index) {
+    case ParamWavetable: params.wavetable = static_cast<int>(value); break;
+    case ParamAttack: params.attack = value; break;
+    case ParamDecay: params.decay = value; break;
+    case ParamSustain: params.sustain = value; break;
+    case ParamRelease: params.release = value; break;
+    case ParamAttackCurve: params.attackCurve = value; break;
+    case ParamReleaseCurve: params.releaseCurve = value; break;
+    case ParamFilterBypass: params.filterBypass = value > 0.5f; break;
+    case ParamCutoff: params.cutoff = value; break;
+    case ParamResonance: params.resonance = value; break;
+    case ParamFegAttack: params.fegAttack = value; break;
+    case ParamFegDecay: params.fegDecay = value; break;
+    case ParamFegSustain: params.fegSustain = value; break;
+    case ParamFegRelease: params.fegRelease = value; break;
+    case ParamFegAmount: params.fegAmount = value; break;
+    case ParamFilterMix: params.filterMix = value; break;
+    case ParamLfoRate: params.lfoRate = value; break;
+    case ParamLfoDepth: params.lfoDepth = value; break;
+    case ParamLfoPitchAmt: params.lfoPitchAmt = value; break;
+    case ParamSubTune: params.subTune = value; break;
+    case ParamSubMix: params.subMix = value; break;
+    case ParamSubTrack: params.subTrack = value; break;
+    case ParamOsc2Tune: params.osc2Tune = value; break;
+    case ParamOsc2Mix: params.osc2Mix = value; break;
+    case ParamOsc2Track: params.osc2Track = value; break;
+    case ParamGain: params.gain = value; break;
+    case ParamUnison: params.unison = static_cast<int>(value); break;
+    case ParamDetune: params.detune = value; break;
+    default: break;
+    }
+}
+
+// Number of sounding voices
+int SynthEngine::getActiveVoiceCount() const {
+    return voices.activeIndex.count;
+}
+
+// Render a block at the engine rate. The block is split at the event offsets, so every event takes effect
+// on its own sample whatever the block size.
+void SynthEngine::render(const SynthEvent *events, int numEvents, float *outL, float *outR, int numSamples) {
+    ScopedFlushDenormals flushDenormals;
+    const float sampleRate = getSampleRate();
+    SIMDSYNTH_PROFILE_ONLY(StageTimer timer(profile, StageParameters));
+
+    // Smoothed voice parameters step once per render, and the voices follow while any of them is still ramping.
+    // Gain and filter mix feed no voice values; they step per sample in the mix.
+    const int hostSamples = (numSamples + osFactor - 1) / osFactor;
+    for (int p = 0; p < NUM_PARAMETERS; ++p) {
+        LinearSmoother *smoother = smootherFor(p);
+        if (smoother == nullptr || PARAMETERS[p].voiceGroups == 0 || !smoother->isSmoothing()) continue;
+        smoother->skip(hostSamples);
+        dirtyGroups |= PARAMETERS[p].voiceGroups;
+    }
+    filter.resonance = smoothedResonance.getCurrentValue();
+
+    // Update parameters if changed; free voices take them at note-on
+    if (dirtyGroups != 0) {
+        updateVoiceParameters(sampleRate, dirtyGroups, false);
+        dirtyGroups = 0;
+    }
+
+    // DC blocker cutoff
+    const float dcCutoff = std::clamp(10.0f * (sampleRate / 44100.0f), 5.0f, 20.0f);
+    dcBlockerAlpha = simdmath::exp(-simdmath::twoPi * dcCutoff / sampleRate);
+
+    // Apply the events due at the current position, then render in chunks up to the next event
+    int e = 0;
+    for (int position = 0; position < numSamples;) {
+        SIMDSYNTH_PROFILE_ONLY(timer.next(StageMidi));
+        while (e < numEvents && events[e].sampleOffset <= position) applyEvent(events[e++]);
+        SIMDSYNTH_PROFILE_ONLY(timer.stop()); // renderChunk times its own stages
+        const int segmentEnd = e < numEvents ? std::min(events[e].sampleOffset, numSamples) : numSamples;
+
+        // Calculate voice scaling
+        const int activeCount = getActiveVoiceCount();
+        float voiceScaling = (activeCount > 0) ? (1.0f / std::sqrt(static_cast<float>(activeCount))) : 1.0f;
+
+        for (int start = position; start < segmentEnd; start += RENDER_CHUNK) {
+            const int chunkSamples = std::min(RENDER_CHUNK, segmentEnd - start);
+            renderChunk(outL != nullptr ? outL + start : nullptr, outR != nullptr ? outR + start : nullptr,
+                        chunkSamples, sampleRate, voiceScaling);
+        }
+        position = segmentEnd;
+    }
+    SIMDSYNTH_PROFILE_ONLY(timer.next(StageMidi));
+    while (e < numEvents) applyEvent(events[e++]); // Offsets at or past the end of the block
+    sampleClock += numSamples / osFactor;
+}
+
+void SynthEngine::applyEvent(const SynthEvent &event) {
+    switch (event.type) {
+    case SynthEvent::Type::NoteOn:
+        noteOn(event.note, event.velocity, event.sampleOffset);
+        break;
+    case SynthEvent::Type::NoteOff:
+        noteOff(event.note);
+        break;
+    case SynthEvent::Type::Controller:
+        controllerChange(event.note, event.velocity);
+        break;
+    }
+}
+
+// Start a note on a free voice, or on a stolen one when all are busy. Velocity is 0 to 1. Finding the voice
+// costs a few mask words or the top of the steal queue, however many voices sound.
+void SynthEngine::noteOn(int note, float velocity, int sampleOffset) {
+    const float sampleRate = getSampleRate();
+    velocity = 0.7f + velocity * 0.3f;
+
+    // The lowest free slot keeps the sounding voices packed into as few kernel batches as possible
+    int voiceIndex = voices.activeIndex.firstFree();
+    if (voiceIndex == -1) {
+        voiceIndex = findVoiceToSteal();
+    }
+
+    VoiceParams &vp = voices.params[voiceIndex];
+    applyVoiceParameters(voiceIndex, GroupAll, sampleRate);
+    voices.setActive(voiceIndex, true);
+    voices.clearState(voiceIndex);
+    voices.released[voiceIndex] = false;
+    voices.isHeld[voiceIndex] = true;
+    voices.sustained[voiceIndex] = false;
+    voices.frequency[voiceIndex] = midiToFreq(note);
+    voices.phaseIncrement[voiceIndex] = voices.frequency[voiceIndex] / sampleRate;
+
+    float initialOffset = (vp.wavetableType == 0) ? nextRandom() * 0.01f : 0.0f;
+    voices.phase[voiceIndex] = initialOffset;
+    voices.subPhase[voiceIndex] = initialOffset * simdmath::twoPi;
+    voices.osc2Phase[voiceIndex] = initialOffset * simdmath::twoPi;
+    voices.lfoPhase[voiceIndex] = nextRandom() * simdmath::twoPi;
+    voices.noteNumber[voiceIndex] = note;
+    voices.velocity[voiceIndex] = velocity;
+    voices.noteOnSample[voiceIndex] = sampleClock + sampleOffset / osFactor;
+    voices.releaseStartAmplitude[voiceIndex] = 0.0f;
+    voices.panSide[voiceIndex] = voiceIndex % 2 * 2.0f - 1.0f;
+    triggerEnvelopes(voiceIndex, sampleRate);
+    voices.noteVoices.add(voiceIndex, note);
+    voices.stealOrder.update(voiceIndex, stealRank(voiceIndex));
+    const float frequencyToIncrement = voices.frequency[voiceIndex] / sampleRate * simdmath::twoPi;
+    voices.subPhaseIncrement[voiceIndex] = frequencyToIncrement * simdmath::semitonesToRatio(vp.subTune) * vp.subTrack;
+    voices.osc2PhaseIncrement[voiceIndex] =
+        frequencyToIncrement * simdmath::semitonesToRatio(vp.osc2Tune) * vp.osc2Track;
+    for (int u = 0; u < vp.unison; ++u) {
+        float baseDetune = vp.detune * (u - (vp.unison - 1) / 2.0f) / (vp.unison - 1 + 0.0001f);
+        float randVar = 1.0f + (nextRandom() - 0.5f) * 0.1f;
+        vp.detuneFactors[u] = simdmath::semitonesToRatio(baseDetune * randVar);
+        vp.unisonPhases[u] = nextRandom() * 0.01f;
+    }
+}
+
+// Release every voice playing a note, or leave it sounding until the sustain pedal comes up. Only the voices
+// on the note's list are visited.
+void SynthEngine::noteOff(int note) {
+    for (int j = voices.noteVoices.first(note); j != -1; j = voices.noteVoices.next[j]) {
+        if (voices.noteNumber[j] != note) continue;
+        if (sustainPedal && !voices.released[j]) {
+            voices.isHeld[j] = false;
+            voices.sustained[j] = true;
+            voices.stealOrder.update(j, stealRank(j));
+        } else {
+            releaseVoice(j);
+        }
+    }
+}
+
+// Start a voice's release
+void SynthEngine::releaseVoice(int v) {
+    voices.released[v] = true;
+    voices.isHeld[v] = false;
+    voices.sustained[v] = false;
+    voices.releaseStartAmplitude[v] = voices.ampEnv.value[v];
+    releaseEnvelopes(v, getSampleRate());
+    voices.stealOrder.update(v, stealRank(v));
+}
+
+// Controllers the engine responds to: sustain pedal (64), all sound off (120) and all notes off (123).
+// Value is 0 to 1.
+void SynthEngine::controllerChange(int controller, float value) {
+    switch (controller) {
+    case 64:
+        sustainPedal = value >= 0.5f;
+        if (sustainPedal) break;
+        for (int k = 0; k < voices.activeIndex.count; ++k) {
+            const int v = voices.activeIndex.list[k];
+            if (voices.sustained[v]) releaseVoice(v);
+        }
+        break;
+    case 120:
+        // Silence at once; the list shrinks as voices leave it, so walk it from the end
+        for (int k = voices.activeIndex.count - 1; k >= 0; --k) {
+            const int v = voices.activeIndex.list[k];
+            voices.setActive(v, false);
+            voices.ampEnv.hold(v, EnvelopeStage::Idle, 0.0f);
+            voices.filterEnv.hold(v, EnvelopeStage::Idle, 0.0f);
+            voices.clearState(v);
+        }
+        break;
+    case 123:
+        for (int k = 0; k < voices.activeIndex.count; ++k) {
+            const int v = voices.activeIndex.list[k];
+            if (!voices.released[v]) releaseVoice(v);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+// Uniform random number in [0, 1)
+float SynthEngine::nextRandom() {
+    return std::uniform_real_distribution<float>(0.0f, 1.0f)(random);
+}
+
+// Convert MIDI note number to frequency
+float SynthEngine::midiToFreq(int midiNote) {
+    return 440.0f * simdmath::semitonesToRatio(static_cast<float>(midiNote - 69));
+}
+
+// Steal rank of a sounding voice; the highest is stolen first. Released voices go first, by the level their
+// release started from (those already below -60 dB after the rest), then voices held only by the sustain
+// pedal, then held voices below half level, then the other held voices; oldest first within each of these.
+uint64_t SynthEngine::stealRank(int v) const {
+    constexpr int groupShift = 62;
+    constexpr uint64_t orderMask = (uint64_t{1} << groupShift) - 1;
+    if (voices.released[v]) {
+        // Non-negative floats order like their bit patterns
+        const float level = voices.ampEnv.value[v] > 0.001f ? std::max(voices.releaseStartAmplitude[v], 0.0f) : 0.0f;
+        uint32_t levelBits;
+        std::memcpy(&levelBits, &level, sizeof(levelBits));
+        return uint64_t{3} << groupShift | levelBits;
+    }
+    const uint64_t group = !voices.isHeld[v] ? 2 : voices.ampEnv.value[v] < 0.5f ? 1 : 0;
+    const uint64_t age = orderMask - (static_cast<uint64_t>(voices.noteOnSample[v]) & orderMask);
+    return group << groupShift | age;
+}
+
+// Find a voice to steal for new notes: the top of the steal queue
+// noteOn resets the stolen voice's oscillator and filter state, so this only has to pick it. The envelopes are
+// left alone: the new note's attack continues from the stolen voice's current level, which avoids a click.
+int SynthEngine::findVoiceToSteal() { return std::max(voices.stealOrder.top(), 0); }
+
+// Number of envelope ticks for a segment length in seconds at the oversampled rate
+static int envelopeTicks(float seconds, float sampleRate) {
+    return std::max(1, static_cast<int>(std::lround(seconds * sampleRate / RENDER_SUB_BLOCK)));
+}
+
+// Move an envelope on from a segment that has just ended
+static void nextEnvelopeSegment(EnvelopeBank &env, int v, float decay, float sustain, float sampleRate) {
+    env.value[v] = env.target[v];
+    switch (env.stage[v]) {
+    case EnvelopeStage::Attack:
+        env.startSegment(v, EnvelopeStage::Decay, sustain, envelopeTicks(decay, sampleRate), 1.5f);
+        break;
+    case EnvelopeStage::Decay:
+        env.hold(v, EnvelopeStage::Sustain, sustain);
+        break;
+    default:
+        env.hold(v, EnvelopeStage::Idle, 0.0f);
+        break;
+    }
+}
+
+// Start the attack of both envelopes from their current level
+void SynthEngine::triggerEnvelopes(int v, float sampleRate) {
+    const VoiceParams &vp = voices.params[v];
+    float velScale = 1.0f / (0.3f + 0.7f * voices.velocity[v]);
+    float attack = std::max(vp.attack, 0.02f) * velScale;
+    float attackCurve = std::clamp(vp.attackCurve, 0.5f, 3.0f);
+    voices.ampEnv.startSegment(v, EnvelopeStage::Attack, 1.0f, envelopeTicks(attack, sampleRate), attackCurve);
+    voices.filterEnv.startSegment(v, EnvelopeStage::Attack, 1.0f, envelopeTicks(vp.fegAttack, sampleRate),
+                                  attackCurve);
+}
+
+// Start the release of both envelopes from their current level
+void SynthEngine::releaseEnvelopes(int v, float sampleRate) {
+    const VoiceParams &vp = voices.params[v];
+    float release = std::max(vp.release, 0.02f);
+    float releaseCurve = std::clamp(vp.releaseCurve, 0.5f, 3.0f);
+    voices.ampEnv.startSegment(v, EnvelopeStage::Release, 0.0f, envelopeTicks(release, sampleRate), releaseCurve);
+    voices.filterEnv.startSegment(v, EnvelopeStage::Release, 0.0f, envelopeTicks(vp.fegRelease, sampleRate),
+                                  releaseCurve);
+}
+
+// Advance the amplitude and filter envelopes of the voices in [begin, end), one kernel batch. They tick once
+// per RENDER_SUB_BLOCK oversampled samples; renderChunk works out which sub-blocks are due a tick.
+void SynthEngine::updateEnvelopes(int begin, int end, bool tick, float sampleRate) {
+    const int lanesEnd = begin + kernels.width;
+    std::copy(voices.ampEnv.value + begin, voices.ampEnv.value + lanesEnd, voices.ampEnv.previous + begin);
+    if (!tick) return;
+
+    kernels.tickEnvelopes(voices.ampEnv, voices.gate, begin, lanesEnd);
+    kernels.tickEnvelopes(voices.filterEnv, voices.gate, begin, lanesEnd);
+
+    // Segment changes, scalar and only where a segment has ended
+    for (int i = begin; i < end; i++) {
+        if (!voices.active[i]) continue;
+
+        const VoiceParams &vp = voices.params[i];
+        const float sustain = std::clamp(vp.sustain, 0.0f, 1.0f);
+        const float decay = std::max(vp.decay, 0.02f);
+
+        // Sustain follows parameter edits
+        if (voices.ampEnv.stage[i] == EnvelopeStage::Sustain) voices.ampEnv.value[i] = sustain;
+        if (voices.filterEnv.stage[i] == EnvelopeStage::Sustain) voices.filterEnv.value[i] = vp.fegSustain;
+
+        if (voices.ampEnv.tick(i)) nextEnvelopeSegment(voices.ampEnv, i, decay, sustain, sampleRate);
+        if (voices.filterEnv.tick(i)) nextEnvelopeSegment(voices.filterEnv, i, vp.fegDecay, vp.fegSustain, sampleRate);
+
+        if (voices.ampEnv.stage[i] == EnvelopeStage::Idle) {
+            voices.setLaneActive(i, false);
+            voices.filterEnv.hold(i, EnvelopeStage::Idle, 0.0f);
+            for (int j = 0; j < 4; j++) {
+                voices.filterStates[j][i] = 0.0f;
+            }
+        }
+    }
+}
+
+// Control-rate stage: advance the LFOs and compute the ladder coefficients once per control period. The
+// audio-rate kernels ramp linearly from the previous period's values to these, so the transcendental math
+// (sin, tan) runs once per voice per period instead of once per oversampled sample. Covers the voices in
+// [begin, end), one kernel batch.
+void SynthEngine::updateControlRate(int begin, int end, float sampleRate, int numSamples) {
+    const float twoPi = simdmath::twoPi;
+    const int lanesEnd = begin + kernels.width;
+
+    alignas(64) float prewarp[VOICE_BANK_SIZE]; // Ladder prewarp angle, wc / 2
+    std::fill(prewarp + begin, prewarp + lanesEnd, 0.0f);
+
+    for (int i = begin; i < end; ++i) {
+        voices.lfoStart[i] = voices.lfoEnd[i];
+        voices.ladderAlphaStart[i] = voices.ladderAlphaEnd[i];
+        voices.ladderResonanceStart[i] = voices.ladderResonanceEnd[i];
+        if (!voices.active[i]) continue;
+
+        float lfoPhase = voices.lfoPhase[i] + voices.params[i].lfoRate * twoPi / sampleRate * numSamples;
+        voices.lfoPhase[i] = lfoPhase - std::floor(lfoPhase / twoPi) * twoPi;
+
+        // Cutoff at the end of the period (smoothed cutoff plus filter envelope modulation)
+        voices.smoothedCutoff[i].skip(numSamples);
+        voices.smoothedFegAmount[i].skip(numSamples);
+        float cutoff = voices.smoothedCutoff[i].getCurrentValue();
+        float egMod = voices.filterEnv.value[i] * voices.smoothedFegAmount[i].getCurrentValue();
+        egMod = std::clamp(egMod, -1.0f, 1.0f);
+        float envMod = std::clamp(egMod * 2000.0f, -2000.0f, 2000.0f);
+
+        cutoff = std::clamp(cutoff + envMod, 20.0f, filter.sampleRate * 0.4f);
+        voices.ladderResonanceEnd[i] =
+            std::clamp(filter.resonance * (1.0f - 0.4f * cutoff / (filter.sampleRate * 0.4f)), 0.0f, 0.5f);
+
+        cutoff = std::clamp(cutoff + envMod, 20.0f, filter.sampleRate * 0.45f);
+        float wc = twoPi * cutoff / filter.sampleRate;
+        prewarp[i] = wc / 2.0f;
+    }
+
+    // One LFO sine and one prewarp tangent per batch and period; inactive lanes keep their old coefficients
+    kernels.controlRate(voices, prewarp, begin, lanesEnd);
+    for (int i = begin; i < end; ++i) {
+        if (voices.active[i]) voices.ladderAlphaEnd[i] = prewarp[i];
+    }
+
+    // A voice that has just started has no previous period to ramp from
+    for (int i = begin; i < end; ++i) {
+        if (!voices.active[i] || voices.controlPrimed[i]) continue;
+        voices.lfoStart[i] = voices.lfoEnd[i];
+        voices.ladderAlphaStart[i] = voices.ladderAlphaEnd[i];
+        voices.ladderResonanceStart[i] = voices.ladderResonanceEnd[i];
+        voices.controlPrimed[i] = true;
+    }
+}
+
+// Refresh the per-voice values in `groups`: for the sounding voices, or for every slot when allSlots is set
+void SynthEngine::updateVoiceParameters(float sampleRate, unsigned groups, bool allSlots) {
+    if (groups & GroupPitch) {
+        const float incrementScale = simdmath::twoPi / sampleRate;
+        subRatio = simdmath::semitonesToRatio(smoothedSubTune.getCurrentValue()) * incrementScale;
+        osc2Ratio = simdmath::semitonesToRatio(smoothedOsc2Tune.getCurrentValue()) * incrementScale;
+    }
+    if (allSlots) {
+        for (int i = 0; i < MAX_VOICE_POLYPHONY; ++i) applyVoiceParameters(i, groups, sampleRate);
+        return;
+    }
+    for (int k = 0; k < voices.activeIndex.count; ++k) {
+        applyVoiceParameters(voices.activeIndex.list[k], groups, sampleRate);
+    }
+}
+
+// Copy the current parameters in `groups` into one voice
+void SynthEngine::applyVoiceParameters(int i, unsigned groups, float sampleRate) {
+    VoiceParams &vp = voices.params[i];
+    if (groups & GroupEnvelope) {
+        vp.attack = params.attack;
+        vp.decay = params.decay;
+        vp.sustain = params.sustain;
+        vp.release = params.release;
+        vp.attackCurve = smoothedAttackCurve.getCurrentValue();
+        vp.releaseCurve = smoothedReleaseCurve.getCurrentValue();
+        vp.fegAttack = params.fegAttack;
+        vp.fegDecay = params.fegDecay;
+        vp.fegSustain = params.fegSustain;
+        vp.fegRelease = params.fegRelease;
+    }
+    if (groups & GroupFilter) {
+        vp.cutoff = params.cutoff;
+        vp.resonance = params.resonance;
+        vp.filterBypass = params.filterBypass ? 1.0f : 0.0f;
+        vp.fegAmount = params.fegAmount;
+        voices.smoothedCutoff[i].setTargetValue(params.cutoff);
+        voices.smoothedFegAmount[i].setTargetValue(params.fegAmount);
+    }
+    if (groups & GroupMix) {
+        vp.lfoRate = smoothedLfoRate.getCurrentValue();
+        vp.lfoDepth = smoothedLfoDepth.getCurrentValue();
+        vp.lfoPitchAmt = params.lfoPitchAmt;
+        vp.subMix = smoothedSubMix.getCurrentValue();
+        vp.osc2Mix = smoothedOsc2Mix.getCurrentValue();
+        vp.wavetableType = params.wavetable;
+    }
+    if (groups & GroupUnison) {
+        // A new unison count gets new phase offsets; a detune move keeps them, so the sound does not jump
+        const int unison = std::clamp(params.unison, 1, maxUnison);
+        const float detune = smoothedDetune.getCurrentValue();
+        if (unison != vp.unison || detune != vp.detune) {
+            const bool countChanged = unison != vp.unison;
+            vp.unison = unison;
+            vp.detune = detune;
+            for (int u = 0; u < vp.unison; ++u) {
+                float detuneCents = vp.detune * (u - (vp.unison - 1) / 2.0f) / (vp.unison - 1 + 0.0001f);
+                vp.detuneFactors[u] = simdmath::semitonesToRatio(detuneCents);
+                if (countChanged) vp.unisonPhases[u] = nextRandom() * 0.01f;
+            }
+        }
+    }
+    if (groups & GroupPitch) {
+        vp.subTune = smoothedSubTune.getCurrentValue();
+        vp.subTrack = smoothedSubTrack.getCurrentValue();
+        vp.osc2Tune = smoothedOsc2Tune.getCurrentValue();
+        vp.osc2Track = smoothedOsc2Track.getCurrentValue();
+        if (voices.active[i]) {
+            voices.phaseIncrement[i] = voices.frequency[i] / sampleRate;
+            voices.subPhaseIncrement[i] = voices.frequency[i] * subRatio * vp.subTrack;
+            voices.osc2PhaseIncrement[i] = voices.frequency[i] * osc2Ratio * vp.osc2Track;
+        }
+    }
+}
+
+// Render one batch of kernels.width voices over a sub-block and accumulate it into mixL/mixR. Per-lane
+// coefficients and mip levels are gathered here in scalar code; the kernel then runs the oscillators,
+// ladder filter and DC blocker across the batch.
+void SynthEngine::renderVoiceBatch(int voiceOffset, int numSamples, float sampleRate, bool filterBypassed,
+                                               const float *filterMix, float *mixL, float *mixR) {
+    BatchSetup setup;
+    setup.unison = 1;
+#if SIMDSYNTH_PROFILING
+    if (profile != nullptr) setup.profile = &batchOutputs[static_cast<size_t>(voiceOffset / kernels.width)].profile;
+    StageTimer timer(setup.profile, StageOscillators);
+#endif
+
+    for (int j = 0; j < kernels.width; ++j) {
+        for (int u = 0; u < maxUnison; ++u) {
+            setup.detune[u][j] = 1.0f;
+            setup.unisonPhase[u][j] = setup.unisonL[u][j] = setup.unisonR[u][j] = 0.0f;
+        }
+        setup.mainMix[j] = setup.subMix[j] = setup.osc2Mix[j] = 0.0f;
+        setup.lfoDepth[j] = setup.lfoPitch[j] = 0.0f;
+        setup.amp[j] = setup.ampStep[j] = 0.0f;
+        setup.leftGain[j] = setup.rightGain[j] = 0.0f;
+        setup.tables[j] = setup.osc2Tables[j] = Wavetables::getSine();
+
+        const int idx = voiceOffset + j;
+        if (idx >= MAX_VOICE_POLYPHONY || !voices.active[idx]) continue;
+        const VoiceParams &vp = voices.params[idx];
+
+        const int unisonVoices = vp.unison;
+        const float panScale = std::clamp(vp.detune / 0.05f, 0.0f, 1.0f);
+        setup.unison = std::max(setup.unison, unisonVoices);
+        for (int u = 0; u < unisonVoices; ++u) {
+            setup.detune[u][j] = vp.detuneFactors[u];
+            setup.unisonPhase[u][j] = vp.unisonPhases[u];
+            float uPan =
+                (unisonVoices > 1) ? (static_cast<float>(u) / (unisonVoices - 1) * 2.0f - 1.0f) * 0.5f : 0.0f;
+            uPan *= panScale;
+            setup.unisonL[u][j] = ((1.0f - uPan) * 0.5f + 0.5f) / static_cast<float>(unisonVoices);
+            setup.unisonR[u][j] = ((1.0f + uPan) * 0.5f + 0.5f) / static_cast<float>(unisonVoices);
+        }
+        float totalMix = std::max(1.0f + vp.subMix + vp.osc2Mix, 1e-6f);
+        setup.mainMix[j] = 2.0f / totalMix;
+        setup.subMix[j] = vp.subMix / totalMix;
+        setup.osc2Mix[j] = vp.osc2Mix / totalMix;
+        setup.lfoDepth[j] = vp.lfoDepth;
+        setup.lfoPitch[j] = vp.lfoPitchAmt;
+        setup.tables[j] = wavetables->get(vp.wavetableType, voices.phaseIncrement[idx] * sampleRate);
+        setup.osc2Tables[j] =
+            wavetables->get(vp.wavetableType, voices.osc2PhaseIncrement[idx] / simdmath::twoPi * sampleRate);
+
+        float pan = voices.panSide[idx] * 0.5f * (vp.unison / 8.0f);
+        setup.leftGain[j] = (1.0f - pan) * 0.5f + 0.5f;
+        setup.rightGain[j] = (1.0f + pan) * 0.5f + 0.5f;
+
+        // Ramp the amplitude from the level before the last envelope tick to the current one
+        const float ampStart = voices.ampEnv.previous[idx] * voices.velocity[idx];
+        const float ampEnd = voices.ampEnv.value[idx] * voices.velocity[idx];
+        setup.ampStep[j] = (ampEnd - ampStart) / static_cast<float>(numSamples);
+        setup.amp[j] = ampStart;
+    }
+    SIMDSYNTH_PROFILE_ONLY(timer.stop()); // The kernel times the oscillators and filter itself
+
+    kernels.renderBatch(voices, voiceOffset, setup, numSamples, filterBypassed, dcBlockerAlpha, filterMix, mixL, mixR);
+}
+
+// Render a chunk of oversampled samples. The values every batch shares (smoothed mix, envelope tick timing)
+// are evaluated here first; the batches up to the highest sounding voice then render independently, on the
+// worker pool when there is one and more than one batch, and their accumulators are mixed in batch order.
+void SynthEngine::renderChunk(float *outL, float *outR, int numSamples, float sampleRate, float voiceScaling) {
+    chunk.numSamples = numSamples;
+    chunk.sampleRate = sampleRate;
+    chunk.filterBypassed = params.filterBypass;
+    for (int n = 0; n < numSamples; ++n) {
+        chunk.filterMix[n] = smoothedFilterMix.getNextValue();
+    }
+    // Envelopes tick once per RENDER_SUB_BLOCK samples; shorter sub-blocks accumulate until a tick is due
+    for (int start = 0, s = 0; start < numSamples; start += RENDER_SUB_BLOCK, ++s) {
+        envelopeSamplesPending += std::min(RENDER_SUB_BLOCK, numSamples - start);
+        chunk.envelopeTick[s] = envelopeSamplesPending >= RENDER_SUB_BLOCK;
+        if (chunk.envelopeTick[s]) envelopeSamplesPending -= RENDER_SUB_BLOCK;
+    }
+
+    const int numBatches = (voices.activeIndex.highest() + kernels.width) / kernels.width;
+    if (workerPool != nullptr && numBatches > 1) {
+        workerPool->run(batchJobs, &SynthEngine::runBatchJob, this, numBatches);
+    } else {
+        for (int batch = 0; batch < numBatches; ++batch) renderBatchChunk(batch);
+    }
+#if SIMDSYNTH_PROFILING
+    if (profile != nullptr) {
+        for (int batch = 0; batch < numBatches; ++batch) profile->take(batchOutputs[batch].profile);
+    }
+    StageTimer timer(profile, StageOutput);
+#endif
+    collectEndedVoices();
+    repackVoices();
+
+    for (int n = 0; n < numSamples; ++n) {
+        float mixL = 0.0f, mixR = 0.0f;
+        for (int batch = 0; batch < numBatches; ++batch) {
+            mixL += batchOutputs[batch].left[n];
+            mixR += batchOutputs[batch].right[n];
+        }
+
+        const float gain = voiceScaling * smoothedGain.getNextValue();
+        float outputSampleL = mixL * gain;
+        float outputSampleR = mixR * gain;
+
+        if (std::isnan(outputSampleL) || !std::isfinite(outputSampleL)) outputSampleL = 0.0f;
+        if (std::isnan(outputSampleR) || !std::isfinite(outputSampleR)) outputSampleR = 0.0f;
+
+        if (outL != nullptr) outL[n] = outputSampleL;
+        if (outR != nullptr) outR[n] = outputSampleR;
+    }
+}
+
+// Render one kernel batch of voices over the current chunk into its accumulator, a sub-block at a time.
+// Touches only the batch's own voice lanes, so batches can run on different threads.
+void SynthEngine::renderBatchChunk(int batch) {
+    const int begin = batch * kernels.width;
+    const int end = std::min(begin + kernels.width, MAX_VOICE_POLYPHONY);
+    BatchOutput &output = batchOutputs[static_cast<size_t>(batch)];
+    std::fill(output.left, output.left + chunk.numSamples, 0.0f);
+    std::fill(output.right, output.right + chunk.numSamples, 0.0f);
+
+    for (int start = 0, s = 0; start < chunk.numSamples; start += RENDER_SUB_BLOCK, ++s) {
+        const int subBlock = std::min(RENDER_SUB_BLOCK, chunk.numSamples - start);
+        SIMDSYNTH_PROFILE_ONLY(StageTimer timer(profile != nullptr ? &output.profile : nullptr, StageEnvelopes));
+        updateEnvelopes(begin, end, chunk.envelopeTick[s], chunk.sampleRate);
+        updateControlRate(begin, end, chunk.sampleRate, subBlock);
+        SIMDSYNTH_PROFILE_ONLY(timer.stop());
+        if (std::find(voices.active + begin, voices.active + end, true) == voices.active + end) continue;
+
+        renderVoiceBatch(begin, subBlock, chunk.sampleRate, chunk.filterBypassed, chunk.filterMix + start,
+                         output.left + start, output.right + start);
+    }
+}
+
+// Take the voices whose envelopes ended during the last chunk out of the index, note lists and steal queue,
+// and move the others whose rank the chunk changed (a held voice crossing half level, a release fading out)
+void SynthEngine::collectEndedVoices() {
+    for (int k = voices.activeIndex.count - 1; k >= 0; --k) {
+        const int v = voices.activeIndex.list[k];
+        if (!voices.active[v])
+            voices.setActive(v, false);
+        else
+            voices.stealOrder.update(v, stealRank(v));
+    }
+}
+
+// Move voices out of the kernel batches past the fewest that can hold them, into the free slots below, so a
+// chunk renders no more batches than the sounding voices need. Only runs once voices ending have left
+// batches partly empty; the moved voices carry all their state and sound the same.
+void SynthEngine::repackVoices() {
+    const int packedEnd = (voices.activeIndex.count + kernels.width - 1) / kernels.width * kernels.width;
+    for (int from = voices.activeIndex.highest(); from >= packedEnd; from = voices.activeIndex.highest()) {
+        voices.moveVoice(from, voices.activeIndex.firstFree());
+    }
+}
+
+void SynthEngine::runBatchJob(void *engine, int batch) {
+    ScopedFlushDenormals flushDenormals; // Workers need the same float mode as the audio thread
+    static_cast<SynthEngine *>(engine)->renderBatchChunk(batch);
+}
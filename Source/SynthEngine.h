@@ -0,0 +1,527 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// SynthEngine.h - The voice engine, independent of JUCE: voices, oscillators, envelopes, ladder filter and
+// wavetables behind a plain render call. The plugin is a thin adapter over it (parameters, MIDI, oversampling,
+// presets); offline tools and benchmarks link the same code through the SimdSynthCore library.
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <type_traits>
+#include <vector>
+#include "ParameterRegistry.h" // Parameter table
+#include "SimdMath.h"          // Vector math
+#include "VoiceKernels.h"      // Voice lanes and per-ISA kernels
+#include "Wavetables.h"        // Shared oscillator tables
+#include "WorkerPool.h"        // Multi-core rendering
+
+// Cold per-voice configuration: envelope times, tuning, mixer levels and other values that only
+// change on parameter updates or note-on, kept out of the per-sample working set. Plain data, so voices
+// are set up and copied without touching the allocator.
+struct VoiceParams {
+        alignas(32) float detuneFactors[maxUnison] = {}; // Precomputed detune factors
+        alignas(32) float unisonPhases[maxUnison] = {};  // Per-unison phase offsets
+        float attackCurve = 2.0f;              // Attack curve exponent
+        float releaseCurve = 3.0f;             // Release curve exponent
+        int wavetableType = 0;                 // Wavetable type (0=sine, 1=saw, 2=square)
+        float attack = 0.1f;                   // Amplitude envelope attack time (seconds)
+        float decay = 0.5f;                    // Amplitude envelope decay time (seconds)
+        float sustain = 0.8f;                  // Amplitude envelope sustain level (0 to 1)
+        float release = 0.2f;                  // Amplitude envelope release time (seconds)
+        float cutoff = 1000.0f;                // Filter cutoff frequency (Hz)
+        float resonance = 0.7f;                // Filter resonance (0 to 1)
+        float filterBypass = 1.0f;             // Filter is on (1) or off (0)
+        float fegAttack = 0.1f;                // Filter envelope attack time (seconds)
+        float fegDecay = 1.0f;                 // Filter envelope decay time (seconds)
+        float fegSustain = 0.5f;               // Filter envelope sustain level (0 to 1)
+        float fegRelease = 0.2f;               // Filter envelope release time (seconds)
+        float fegAmount = 0.5f;                // Filter envelope modulation amount (-1 to 1)
+        float lfoRate = 1.0f;                  // LFO rate (Hz)
+        float lfoDepth = 0.05f;                // LFO depth (0 to 0.5)
+        float lfoPitchAmt = 0.05f;             // LFO Pitch amount
+        float subTune = -12.0f;                // Sub-oscillator tuning (semitones)
+        float subMix = 0.5f;                   // Sub-oscillator mix (0 to 1)
+        float subTrack = 1.0f;                 // Sub-oscillator keyboard tracking (0 to 1)
+        float osc2Tune = -24.0f;               // New oscillator tuning (default: -2 octaves)
+        float osc2Mix = 0.3f;                  // New oscillator mix (default: 0.3)
+        float osc2Track = 1.0f;                // New oscillator tracking (default: full tracking)
+        float osc2PhaseOffset = 0.0f;          // Phase offset of the second oscillator
+        int unison = 1;                        // Number of unison voices (1 to 8)
+        float detune = 0.01f;                  // Unison detune amount (0 to 0.1)
+        float crossfade = 0.0f;                // Crossfade progress for wavetable changes (0 to 1)
+};
+static_assert(std::is_trivially_copyable_v<VoiceParams>, "VoiceParams must stay plain data");
+
+// Linear ramp to a target over a fixed number of samples; the engine's stand-in for
+// juce::LinearSmoothedValue, with the same semantics
+class LinearSmoother {
+    public:
+        explicit LinearSmoother(float initial = 0.0f) : current(initial), target(initial) {}
+
+        // Set the ramp length and jump to the target
+        void reset(double sampleRate, double rampSeconds) {
+            stepsToTarget = static_cast<int>(std::floor(rampSeconds * sampleRate));
+            setCurrentAndTargetValue(target);
+        }
+
+        void setCurrentAndTargetValue(float value) {
+            current = target = value;
+            countdown = 0;
+        }
+
+        void setTargetValue(float value) {
+            if (value == target) return;
+            if (stepsToTarget <= 0) {
+                setCurrentAndTargetValue(value);
+                return;
+            }
+            target = value;
+            countdown = stepsToTarget;
+            step = (target - current) / static_cast<float>(countdown);
+        }
+
+        float getNextValue() {
+            if (countdown <= 0) return target;
+            current = --countdown > 0 ? current + step : target;
+            return current;
+        }
+
+        // Advance numSamples at once
+        float skip(int numSamples) {
+            if (numSamples >= countdown) {
+                setCurrentAndTargetValue(target);
+                return target;
+            }
+            current += step * static_cast<float>(numSamples);
+            countdown -= numSamples;
+            return current;
+        }
+
+        float getCurrentValue() const { return current; }
+        bool isSmoothing() const { return countdown > 0; }
+        float getTargetValue() const { return target; }
+
+    private:
+        float current = 0.0f, target = 0.0f, step = 0.0f;
+        int countdown = 0;
+        int stepsToTarget = 0;
+};
+
+// The sounding voices, as a bitmask in slot order (free-slot search, batch occupancy) and as a dense list
+// for the loops that only visit sounding voices
+struct ActiveVoiceIndex {
+        static constexpr int MASK_WORDS = (MAX_VOICE_POLYPHONY + 63) / 64;
+
+        uint64_t mask[MASK_WORDS] = {};         // Bit v set while voice v sounds
+        int list[MAX_VOICE_POLYPHONY] = {};     // Sounding voices, in no particular order
+        int position[MAX_VOICE_POLYPHONY] = {}; // Index of each listed voice in list
+        int count = 0;                          // Number of sounding voices
+
+        bool contains(int v) const { return (mask[v >> 6] >> (v & 63)) & 1u; }
+
+        void add(int v) {
+            if (contains(v)) return;
+            mask[v >> 6] |= uint64_t{1} << (v & 63);
+            position[v] = count;
+            list[count++] = v;
+        }
+
+        void remove(int v) {
+            if (!contains(v)) return;
+            mask[v >> 6] &= ~(uint64_t{1} << (v & 63));
+            const int last = list[--count];
+            list[position[v]] = last;
+            position[last] = position[v];
+        }
+
+        // Lowest free slot, or -1 when every voice sounds
+        int firstFree() const {
+            for (int w = 0; w < MASK_WORDS; ++w) {
+                if (~mask[w] == 0) continue;
+                const int v = w * 64 + __builtin_ctzll(~mask[w]);
+                return v < MAX_VOICE_POLYPHONY ? v : -1;
+            }
+            return -1;
+        }
+
+        // Highest sounding slot, or -1 when none sounds
+        int highest() const {
+            for (int w = MASK_WORDS - 1; w >= 0; --w) {
+                if (mask[w] != 0) return w * 64 + 63 - __builtin_clzll(mask[w]);
+            }
+            return -1;
+        }
+};
+
+// The sounding voices of each MIDI note as intrusive doubly linked lists, so a note-off visits only the voices
+// of its note. Notes share a list when they agree in the low 7 bits, so callers check the note number.
+struct NoteVoiceMap {
+        static constexpr int NUM_NOTES = 128;
+
+        int head[NUM_NOTES];           // First voice of each note, or -1
+        int next[MAX_VOICE_POLYPHONY]; // Next voice of the same note, or -1
+        int prev[MAX_VOICE_POLYPHONY]; // Previous voice of the same note, or -1
+        int list[MAX_VOICE_POLYPHONY]; // List a voice is on, or -1
+
+        NoteVoiceMap() {
+            std::fill(std::begin(head), std::end(head), -1);
+            std::fill(std::begin(list), std::end(list), -1);
+        }
+
+        int first(int note) const { return head[note & (NUM_NOTES - 1)]; }
+
+        // Put a voice on a note's list, taking it off any other
+        void add(int v, int note) {
+            remove(v);
+            const int n = note & (NUM_NOTES - 1);
+            list[v] = n;
+            prev[v] = -1;
+            next[v] = head[n];
+            if (head[n] != -1) prev[head[n]] = v;
+            head[n] = v;
+        }
+
+        void remove(int v) {
+            if (list[v] == -1) return;
+            if (prev[v] != -1)
+                next[prev[v]] = next[v];
+            else
+                head[list[v]] = next[v];
+            if (next[v] != -1) prev[next[v]] = prev[v];
+            list[v] = -1;
+        }
+};
+
+// The sounding voices as a binary max-heap on their steal rank (SynthEngine::stealRank), so the voice to steal
+// is the top and a rank change costs O(log n). Of two voices with the same rank the lower slot goes first.
+struct StealQueue {
+        uint64_t rank[MAX_VOICE_POLYPHONY] = {}; // Rank of each queued voice
+        int heap[MAX_VOICE_POLYPHONY] = {};      // Queued voices, in heap order
+        int position[MAX_VOICE_POLYPHONY];       // Index of each voice in heap, or -1 when not queued
+        int count = 0;                           // Number of queued voices
+
+        StealQueue() { std::fill(std::begin(position), std::end(position), -1); }
+
+        bool contains(int v) const { return position[v] != -1; }
+        int top() const { return count > 0 ? heap[0] : -1; } // Voice to steal, or -1 when none is queued
+
+        // Queue a voice, or move it to its new rank
+        void update(int v, uint64_t newRank) {
+            if (contains(v) && rank[v] == newRank) return;
+            rank[v] = newRank;
+            if (!contains(v)) {
+                position[v] = count;
+                heap[count++] = v;
+            }
+            siftUp(position[v]);
+            siftDown(position[v]);
+        }
+
+        void remove(int v) {
+            if (!contains(v)) return;
+            const int i = position[v];
+            const int last = heap[--count];
+            position[v] = -1;
+            if (last == v) return;
+            place(i, last);
+            siftUp(i);
+            siftDown(position[last]);
+        }
+
+    private:
+        bool above(int a, int b) const { return rank[a] != rank[b] ? rank[a] > rank[b] : a < b; }
+
+        void place(int i, int v) {
+            heap[i] = v;
+            position[v] = i;
+        }
+
+        void siftUp(int i) {
+            const int v = heap[i];
+            for (; i > 0 && above(v, heap[(i - 1) / 2]); i = (i - 1) / 2) place(i, heap[(i - 1) / 2]);
+            place(i, v);
+        }
+
+        void siftDown(int i) {
+            const int v = heap[i];
+            for (int child = 2 * i + 1; child < count; i = child, child = 2 * i + 1) {
+                if (child + 1 < count && above(heap[child + 1], heap[child])) ++child;
+                if (!above(heap[child], v)) break;
+                place(i, heap[child]);
+            }
+            place(i, v);
+        }
+};
+
+// Voice storage: the SIMD lanes the kernels work on, plus per-voice bookkeeping and the cold
+// VoiceParams block alongside.
+struct VoiceBank : VoiceLanes {
+        ActiveVoiceIndex activeIndex;                 // Sounding voices, kept in step with active[]
+        NoteVoiceMap noteVoices;                      // Sounding voices by note, for note-off
+        StealQueue stealOrder;                        // Sounding voices by steal rank, for note-on
+        bool controlPrimed[MAX_VOICE_POLYPHONY] = {}; // False until a voice's first control period
+
+        // Per-voice bookkeeping
+        bool active[MAX_VOICE_POLYPHONY] = {};                 // Is the voice currently active?
+        bool released[MAX_VOICE_POLYPHONY] = {};               // Has the voice been released (note-off)?
+        bool isHeld[MAX_VOICE_POLYPHONY] = {};                 // Is the note currently held?
+        bool sustained[MAX_VOICE_POLYPHONY] = {};              // Note is off but held by the sustain pedal
+        int noteNumber[MAX_VOICE_POLYPHONY] = {};              // MIDI note number
+        float frequency[MAX_VOICE_POLYPHONY] = {};             // Base frequency of the note (Hz)
+        float velocity[MAX_VOICE_POLYPHONY] = {};              // Note velocity (0 to 1)
+        int64_t noteOnSample[MAX_VOICE_POLYPHONY] = {};        // Host sample clock at note-on
+        float releaseStartAmplitude[MAX_VOICE_POLYPHONY] = {}; // Amplitude at release start
+        float panSide[MAX_VOICE_POLYPHONY] = {};               // -1 (left) or 1 (right), fixed at note-on
+        LinearSmoother smoothedCutoff[MAX_VOICE_POLYPHONY];
+        LinearSmoother smoothedFegAmount[MAX_VOICE_POLYPHONY];
+
+        // Cold configuration
+        VoiceParams params[MAX_VOICE_POLYPHONY];
+
+        // Mark a voice as sounding or silent, keeping the SIMD gate lane and the index in sync. A voice that
+        // stops sounding also leaves the note lists and the steal queue; note-on puts one on them.
+        void setActive(int v, bool isActive) {
+            setLaneActive(v, isActive);
+            if (isActive) {
+                activeIndex.add(v);
+            } else {
+                activeIndex.remove(v);
+                noteVoices.remove(v);
+                stealOrder.remove(v);
+            }
+        }
+
+        // Start or end a voice in its own lane only, for render jobs that must not touch the shared index;
+        // SynthEngine::collectEndedVoices brings the index up to date afterwards
+        void setLaneActive(int v, bool isActive) {
+            active[v] = isActive;
+            gate[v] = isActive ? 1.0f : 0.0f;
+        }
+
+        // Move a sounding voice to a free slot, whole: lanes, envelopes, bookkeeping and parameters
+        void moveVoice(int from, int to) {
+            copyVoice(from, to);
+            controlPrimed[to] = controlPrimed[from];
+            released[to] = released[from];
+            isHeld[to] = isHeld[from];
+            sustained[to] = sustained[from];
+            noteNumber[to] = noteNumber[from];
+            frequency[to] = frequency[from];
+            velocity[to] = velocity[from];
+            noteOnSample[to] = noteOnSample[from];
+            releaseStartAmplitude[to] = releaseStartAmplitude[from];
+            panSide[to] = panSide[from];
+            smoothedCutoff[to] = smoothedCutoff[from];
+            smoothedFegAmount[to] = smoothedFegAmount[from];
+            params[to] = params[from];
+            setActive(to, true);
+            noteVoices.add(to, noteNumber[from]);
+            stealOrder.update(to, stealOrder.rank[from]);
+
+            setActive(from, false);
+            ampEnv.hold(from, EnvelopeStage::Idle, 0.0f);
+            filterEnv.hold(from, EnvelopeStage::Idle, 0.0f);
+            clearState(from);
+        }
+
+        // Clear the oscillator and filter state of one voice
+        void clearState(int v) {
+            phase[v] = subPhase[v] = osc2Phase[v] = lfoPhase[v] = 0.0f;
+            for (int j = 0; j < 4; j++) {
+                filterStates[j][v] = 0.0f;
+            }
+            dcState[v] = 0.0f;
+            controlPrimed[v] = false;
+        }
+};
+
+// Structure to hold shared filter parameters for the ladder filter
+struct Filter {
+        float sampleRate = 44100.0f; // Sample rate for filter calculations
+        float resonance = 0.7f;      // Resonance parameter (scaled in updateControlRate)
+};
+
+// Every user-facing parameter in plain units; defaults match PARAMETERS
+struct SynthParams {
+        int wavetable = 0;         // 0=sine, 1=saw, 2=square
+        float attack = 0.1f;       // Amplitude envelope, seconds
+        float decay = 0.5f;        // Seconds
+        float sustain = 0.8f;      // 0 to 1
+        float release = 0.2f;      // Seconds
+        float attackCurve = 2.0f;  // Attack curve exponent
+        float releaseCurve = 3.0f; // Release curve exponent
+        bool filterBypass = false; // Skip the ladder filter and DC blocker
+        float cutoff = 2000.0f;    // Filter cutoff, Hz
+        float resonance = 0.9f;    // 0 to 1
+        float fegAttack = 0.1f;    // Filter envelope, seconds
+        float fegDecay = 1.0f;     // Seconds
+        float fegSustain = 0.8f;   // 0 to 1
+        float fegRelease = 0.2f;   // Seconds
+        float fegAmount = 0.8f;    // -1 to 1
+        float filterMix = 1.0f;    // Wet/dry, 0 to 1
+        float lfoRate = 5.0f;      // Hz
+        float lfoDepth = 0.5f;     // 0 to 1
+        float lfoPitchAmt = 0.1f;  // 0 to 0.5
+        float subTune = -12.0f;    // Semitones
+        float subMix = 0.7f;       // 0 to 1
+        float subTrack = 1.0f;     // Keyboard tracking, 0 to 1
+        float osc2Tune = 0.0f;     // Semitones
+        float osc2Mix = 0.5f;      // 0 to 1
+        float osc2Track = 1.0f;    // Keyboard tracking, 0 to 1
+        float gain = 1.0f;         // Output gain, 0 to 2
+        int unison = 1;            // Unison voices, 1 to maxUnison
+        float detune = 0.01f;      // Unison detune, 0 to 0.1
+};
+
+// A field of SynthParams by ParameterIndex, in the units of PARAMETERS. Parameters that are not part of
+// SynthParams read as 0 and are ignored when set.
+float getParameterValue(const SynthParams &params, int index);
+void setParameterValue(SynthParams &params, int index, float value);
+
+// A note event for one render call
+struct SynthEvent {
+        enum class Type : uint8_t { NoteOn, NoteOff, Controller };
+        Type type = Type::NoteOn;
+        int sampleOffset = 0;  // Position within the rendered block, in engine-rate samples
+        int note = 69;         // MIDI note number, or the controller number
+        float velocity = 1.0f; // 0 to 1: note-on velocity, or the controller value
+};
+
+// The synthesizer voice engine. Renders at the engine rate, the host rate times the oversampling factor;
+// resampling to the host rate is the caller's job. Not thread-safe: call everything from one thread, or
+// hand parameters over with the same care as any other audio-thread state. With a WorkerPool, render spreads
+// the voice batches over the pool's threads; the output is the same as without one.
+class SynthEngine {
+    public:
+        explicit SynthEngine(uint32_t seed = 1);
+
+        // Build the tables for a host rate and reset all voices
+        void prepare(double hostSampleRate, int oversamplingFactor);
+
+        // Switch the oversampling factor, keeping sounding voices and envelope timing intact
+        void setOversamplingFactor(int factor);
+
+        // New parameter values; smoothed parameters ramp to them unless `jump` is set
+        void setParameters(const SynthParams &newParams, bool jump = false);
+
+        // Render numSamples engine-rate samples into outL/outR, applying each of `events` (sorted by
+        // sampleOffset) at its own sample. Either output may be null.
+        void render(const SynthEvent *events, int numEvents, float *outL, float *outR, int numSamples);
+
+        // Render on a shared pool of threads, or on the calling thread only when null. The pool must outlive
+        // the engine or be detached first.
+        void setWorkerPool(WorkerPool *pool) { workerPool = pool; }
+
+        const SynthParams &getParameters() const { return params; }
+        double getHostSampleRate() const { return filter.sampleRate; }
+        int getOversamplingFactor() const { return osFactor; }
+        float getSampleRate() const { return filter.sampleRate * osFactor; } // Engine rate
+        int getActiveVoiceCount() const;
+        const KernelTable &getKernels() const { return kernels; }
+#if SIMDSYNTH_PROFILING
+        // Time render's stages into `counters`, which belong to the thread calling render, or stop when null
+        void setProfileCounters(ProfileCounters *counters) { profile = counters; }
+#endif
+
+    private:
+        // Voice management and envelope processing
+        void noteOn(int note, float velocity, int sampleOffset);
+        void noteOff(int note);
+        void releaseVoice(int v);                                       // Start a voice's release
+        void controllerChange(int controller, float value);             // Sustain pedal and channel mode messages
+        void applyEvent(const SynthEvent &event);                       // One note or controller event
+        int findVoiceToSteal();                                         // Select a voice for stealing
+        uint64_t stealRank(int v) const;                                // Steal order key of a sounding voice
+        void triggerEnvelopes(int v, float sampleRate);                 // Start both envelope attacks
+        void releaseEnvelopes(int v, float sampleRate);                 // Start both envelope releases
+        void updateVoiceParameters(float sampleRate, unsigned groups, bool allSlots); // Refresh voice values
+        void applyVoiceParameters(int v, unsigned groups, float sampleRate);          // Refresh one voice
+        void collectEndedVoices();                                      // Drop ended voices, refresh steal ranks
+        void repackVoices();                                            // Fill batch gaps left by ended voices
+
+        // Rendering. The per-batch stages work on voices [begin, end) of one kernel batch.
+        void updateEnvelopes(int begin, int end, bool tick, float sampleRate);        // Advance the envelopes
+        void updateControlRate(int begin, int end, float sampleRate, int numSamples); // LFOs, filter coefficients
+        void renderChunk(float *outL, float *outR, int numSamples, float sampleRate, float voiceScaling);
+        void renderBatchChunk(int batch);                 // One batch over the chunk, into its accumulator
+        static void runBatchJob(void *engine, int batch); // WorkerPool entry point for renderBatchChunk
+        void renderVoiceBatch(int voiceOffset, int numSamples, float sampleRate, bool filterBypassed,
+                              const float *filterMix, float *mixL, float *mixR);
+
+        // Utility functions
+        float nextRandom();              // Uniform in [0, 1)
+        float midiToFreq(int midiNote);  // Convert MIDI note to frequency
+
+        LinearSmoother *smootherFor(int index); // The engine-wide smoother of a parameter, or null
+
+        SynthParams params;
+        unsigned dirtyGroups = GroupAll; // VoiceParamGroups to refresh at the next render
+        float subRatio = 0.0f;           // Sub-oscillator phase increment per Hz of note frequency
+        float osc2Ratio = 0.0f;          // Second oscillator phase increment per Hz of note frequency
+
+        // Smoothed parameters for reducing zipper noise
+        LinearSmoother smoothedGain;      // Smoothed output gain
+        LinearSmoother smoothedResonance; // Smoothed filter resonance
+        LinearSmoother smoothedFilterMix;
+        LinearSmoother smoothedLfoRate;      // Smoothed LFO rate
+        LinearSmoother smoothedLfoDepth;     // Smoothed LFO depth
+        LinearSmoother smoothedSubMix;       // Smoothed sub-oscillator mix
+        LinearSmoother smoothedSubTune;      // Smoothed sub-oscillator tuning
+        LinearSmoother smoothedSubTrack;     // Smoothed sub-oscillator tracking
+        LinearSmoother smoothedDetune;       // Smoothed unison detune
+        LinearSmoother smoothedOsc2Mix;      // Smoothed second oscillator mix
+        LinearSmoother smoothedOsc2Tune;     // Smoothed second oscillator tuning
+        LinearSmoother smoothedOsc2Track;    // Smoothed second oscillator tracking
+        LinearSmoother smoothedAttackCurve;  // Smoothed attack curve
+        LinearSmoother smoothedReleaseCurve; // Smoothed release curve
+
+        // Rendering runs in chunks of several control periods. Each kernel batch renders a whole chunk as one
+        // job into its own accumulator, and the accumulators are summed in batch order, so the mix does not
+        // depend on which thread ran which batch.
+        static constexpr int RENDER_CHUNK = 8 * RENDER_SUB_BLOCK;
+        struct alignas(64) BatchOutput {
+                float left[RENDER_CHUNK];
+                float right[RENDER_CHUNK];
+#if SIMDSYNTH_PROFILING
+                ProfileCounters profile; // The batch job's stages, moved to the engine's after each chunk
+#endif
+        };
+        struct ChunkSetup { // Values shared by the batch jobs of one chunk, set before they start
+                float filterMix[RENDER_CHUNK];                      // Smoothed wet/dry mix per sample
+                bool envelopeTick[RENDER_CHUNK / RENDER_SUB_BLOCK]; // Envelope tick due in each sub-block
+                int numSamples = 0;
+                float sampleRate = 44100.0f;
+                bool filterBypassed = false;
+        };
+        WorkerPool *workerPool = nullptr;      // Shared render threads, or null
+        WorkerPool::JobGroup batchJobs;        // Dispatch of the batch jobs
+        ChunkSetup chunk;                      // Current chunk
+        std::vector<BatchOutput> batchOutputs; // One accumulator per kernel batch
+#if SIMDSYNTH_PROFILING
+        ProfileCounters *profile = nullptr; // Stage timings, or null when not timing
+#endif
+
+        // Voice and filter data
+        VoiceBank voices;                                  // Polyphonic voices, structure-of-arrays
+        const KernelTable &kernels = selectKernels();      // Voice kernels for this CPU
+        Filter filter;                                     // Shared filter instance
+        int osFactor = 1;                                  // Oversampling factor the engine runs at
+        int64_t sampleClock = 0;                           // Host samples since prepare
+        int envelopeSamplesPending = 0;                    // Engine samples since the last envelope tick
+        bool sustainPedal = false;                         // MIDI controller 64 is down
+        float dcBlockerAlpha = 0.0f;                       // DC blocker coefficient, per control period
+        std::mt19937 random;                               // Phase offsets and unison spread
+
+        // Lookup tables for oscillator waveforms
+        std::shared_ptr<const Wavetables> wavetables; // Band-limited mips for the host rate, shared
+};
@@ -0,0 +1,42 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// TripleBuffer.h - Hands the latest version of a value from one writer thread to one reader thread. The writer
+// fills a spare slot and swaps it in; the reader swaps out the newest slot. Neither ever waits, so either side
+// can be the audio thread.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+template <typename T>
+class TripleBuffer {
+    public:
+        // Publish a new version; writer thread only
+        void write(const T &value) {
+            slots[back] = value;
+            back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX;
+        }
+
+        // Take the newest version if one was published since the last read; reader thread only
+        bool read(T &value) {
+            if ((middle.load(std::memory_order_relaxed) & FRESH) == 0) return false;
+            front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+            value = slots[front];
+            return true;
+        }
+
+    private:
+        static constexpr uint32_t INDEX = 3; // Slot bits of middle
+        static constexpr uint32_t FRESH = 4; // Set while middle holds a version the reader has not taken
+
+        T slots[3] = {};
+        uint32_t back = 0;               // Writer's spare slot
+        uint32_t front = 1;              // Reader's slot
+        std::atomic<uint32_t> middle{2}; // Slot handed between them
+};
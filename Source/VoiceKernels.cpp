@@ -0,0 +1,66 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// VoiceKernels.cpp - Picks the kernel table for the running CPU.
+
+#include "VoiceKernels.h"
+
+#include <cstdlib>
+#include <cstring>
+
+extern const KernelTable scalarKernels;
+#if defined(__x86_64__) || defined(_M_X64)
+extern const KernelTable sse41Kernels;
+extern const KernelTable avx2Kernels;
+extern const KernelTable avx512Kernels;
+#elif defined(__aarch64__) || defined(__arm64__)
+extern const KernelTable neonKernels;
+#endif
+
+struct KernelCandidate {
+        const KernelTable *table;
+        bool supported;
+};
+
+// Every table built for this architecture, widest first
+static int kernelCandidates(KernelCandidate *out) {
+    int count = 0;
+#if defined(__x86_64__) || defined(_M_X64)
+    __builtin_cpu_init();
+    out[count++] = {&avx512Kernels, __builtin_cpu_supports("avx512f") != 0};
+    out[count++] = {&avx2Kernels, __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")};
+    out[count++] = {&sse41Kernels, __builtin_cpu_supports("sse4.1") != 0};
+#elif defined(__aarch64__) || defined(__arm64__)
+    out[count++] = {&neonKernels, true};
+#endif
+    out[count++] = {&scalarKernels, true};
+    return count;
+}
+
+static const KernelTable &chooseKernels() {
+    KernelCandidate candidates[5];
+    const int count = kernelCandidates(candidates);
+
+    // SIMDSYNTH_ISA forces one instruction set, e.g. to benchmark each path on the same machine
+    if (const char *forced = std::getenv("SIMDSYNTH_ISA")) {
+        for (int i = 0; i < count; ++i) {
+            if (std::strcmp(forced, candidates[i].table->name) == 0 && candidates[i].supported)
+                return *candidates[i].table;
+        }
+    }
+
+    for (int i = 0; i < count; ++i) {
+        if (candidates[i].supported) return *candidates[i].table;
+    }
+    return scalarKernels;
+}
+
+const KernelTable &selectKernels() {
+    static const KernelTable &kernels = chooseKernels();
+    return kernels;
+}
@@ -0,0 +1,209 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// VoiceKernels.h - The voice state the SIMD kernels work on and the per-instruction-set kernel tables.
+// Nothing here depends on JUCE, so the kernel translation units can be compiled with their own ISA flags
+// without pulling framework code into them.
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include "Profiler.h" // Stage timers, in profiling builds
+
+// Constants for wavetable size and polyphony. The voice count is a build option (SIMDSYNTH_MAX_VOICES);
+// per-block cost follows the sounding voices, not the slots.
+#ifndef SIMDSYNTH_MAX_VOICES
+#define SIMDSYNTH_MAX_VOICES 128
+#endif
+#if DEBUG
+static constexpr int MAX_VOICE_POLYPHONY = 4; // Maximum number of simultaneous voices
+#else
+static constexpr int MAX_VOICE_POLYPHONY = SIMDSYNTH_MAX_VOICES; // Maximum number of simultaneous voices
+#endif
+static_assert(MAX_VOICE_POLYPHONY >= 1 && MAX_VOICE_POLYPHONY <= 1024, "Voice count must be 1 to 1024");
+
+static constexpr int WAVETABLE_SIZE = 8192; // Size of wavetable lookup tables
+static constexpr int maxUnison = 8; // Unison voices per note; matches the range of the unison parameter
+
+// Control period in oversampled samples. Modulation (LFOs, envelopes, filter coefficients) is evaluated once per
+// period and ramped linearly across it, and voices are rendered one period per batch pass.
+#ifndef SIMDSYNTH_CONTROL_PERIOD
+#define SIMDSYNTH_CONTROL_PERIOD 32
+#endif
+static constexpr int RENDER_SUB_BLOCK = SIMDSYNTH_CONTROL_PERIOD;
+static_assert(RENDER_SUB_BLOCK >= 16 && RENDER_SUB_BLOCK <= 64, "Control period must be 16 to 64 samples");
+
+// Widest kernel batch (AVX-512). The voice bank is padded to a multiple of it so every kernel, whatever
+// its width, loads and stores whole aligned batches.
+static constexpr int MAX_SIMD_WIDTH = 16;
+static constexpr int VOICE_BANK_SIZE = (MAX_VOICE_POLYPHONY + MAX_SIMD_WIDTH - 1) / MAX_SIMD_WIDTH * MAX_SIMD_WIDTH;
+
+// Envelope segment stages
+enum class EnvelopeStage : uint8_t { Idle, Attack, Decay, Sustain, Release };
+
+// Structure-of-arrays envelope state for all voices. A segment is the recurrence
+// value = value * mul + add, evaluated once per envelope tick (RENDER_SUB_BLOCK oversampled samples),
+// so a batch of voices advances with one SIMD multiply-add. Segments are exponential curves matched to
+// x^curve at their midpoint and land on their target after exactly ticksLeft ticks.
+struct EnvelopeBank {
+        alignas(64) float value[VOICE_BANK_SIZE] = {};    // Current level (0 to 1)
+        alignas(64) float previous[VOICE_BANK_SIZE] = {}; // Level before the last tick, for per-sample ramps
+        alignas(64) float mul[VOICE_BANK_SIZE];           // Per-tick multiplier of the current segment
+        alignas(64) float add[VOICE_BANK_SIZE] = {};      // Per-tick offset of the current segment
+        float target[MAX_VOICE_POLYPHONY] = {};           // Level at the end of the current segment
+        int ticksLeft[MAX_VOICE_POLYPHONY] = {};          // Ticks until the current segment ends
+        EnvelopeStage stage[MAX_VOICE_POLYPHONY] = {};
+
+        EnvelopeBank() { std::fill(std::begin(mul), std::end(mul), 1.0f); }
+
+        // Hold a constant level (sustain or idle)
+        void hold(int v, EnvelopeStage s, float level) {
+            value[v] = target[v] = level;
+            mul[v] = 1.0f;
+            add[v] = 0.0f;
+            ticksLeft[v] = 0;
+            stage[v] = s;
+        }
+
+        // Start a segment from the current level to `end` over `ticks`, shaped like x^curve
+        void startSegment(int v, EnvelopeStage s, float end, int ticks, float curve) {
+            ticks = std::max(ticks, 1);
+            // An exponential segment y = (e^(a x) - 1) / (e^a - 1) passes through (0.5, 0.5^curve) when
+            // e^(a / 2) = 2^curve - 1; as a recurrence that is y' = g * y + c with g = e^(a / ticks)
+            const double shape = 2.0 * std::log(std::max(std::pow(2.0, static_cast<double>(curve)) - 1.0, 1e-6));
+            double g = 1.0, c = 1.0 / ticks;
+            if (std::abs(shape) > 1e-4) {
+                g = std::exp(shape / ticks);
+                c = (g - 1.0) / (std::pow(g, ticks) - 1.0);
+            }
+            const double start = value[v];
+            mul[v] = static_cast<float>(g);
+            add[v] = static_cast<float>((1.0 - g) * start + (end - start) * c);
+            target[v] = end;
+            ticksLeft[v] = ticks;
+            stage[v] = s;
+        }
+
+        // Stretch the remaining segment by `ratio` ticks per old tick, keeping its duration in seconds
+        void rescale(int v, double ratio) {
+            if (ticksLeft[v] <= 0) return;
+            ticksLeft[v] = std::max(1, static_cast<int>(std::lround(ticksLeft[v] * ratio)));
+            if (mul[v] == 1.0f) {
+                add[v] = static_cast<float>(add[v] / ratio);
+            } else {
+                const double fixedPoint = add[v] / (1.0 - mul[v]);
+                mul[v] = static_cast<float>(std::pow(static_cast<double>(mul[v]), 1.0 / ratio));
+                add[v] = static_cast<float>(fixedPoint * (1.0 - mul[v]));
+            }
+        }
+
+        // Count down one tick; true when a timed segment has just ended
+        bool tick(int v) { return ticksLeft[v] > 0 && --ticksLeft[v] == 0; }
+
+        // Copy one voice's envelope to another slot
+        void copyVoice(int from, int to) {
+            value[to] = value[from];
+            previous[to] = previous[from];
+            mul[to] = mul[from];
+            add[to] = add[from];
+            target[to] = target[from];
+            ticksLeft[to] = ticksLeft[from];
+            stage[to] = stage[from];
+        }
+};
+
+// Structure-of-arrays voice lanes. Each hot per-sample field is a 64-byte aligned array with one lane
+// per voice, so a batch of voices is a single aligned load/store at offset batch * width.
+struct VoiceLanes {
+        // Oscillator state
+        alignas(64) float phase[VOICE_BANK_SIZE] = {};              // Main oscillator phase (0 to 1)
+        alignas(64) float phaseIncrement[VOICE_BANK_SIZE] = {};     // Main oscillator phase increment per sample
+        alignas(64) float subPhase[VOICE_BANK_SIZE] = {};           // Sub-oscillator phase (radians)
+        alignas(64) float subPhaseIncrement[VOICE_BANK_SIZE] = {};  // Sub-oscillator phase increment per sample
+        alignas(64) float osc2Phase[VOICE_BANK_SIZE] = {};          // Second oscillator phase (radians)
+        alignas(64) float osc2PhaseIncrement[VOICE_BANK_SIZE] = {}; // Second oscillator phase increment
+        alignas(64) float lfoPhase[VOICE_BANK_SIZE] = {};           // LFO phase (radians)
+
+        // Filter state
+        alignas(64) float filterStates[4][VOICE_BANK_SIZE] = {}; // Ladder filter state, [stage][voice]
+        alignas(64) float dcState[VOICE_BANK_SIZE] = {};         // Per-voice DC blocker state
+
+        // Control-rate ramps, each running from the previous control period's end value to this one's
+        alignas(64) float lfoStart[VOICE_BANK_SIZE] = {};             // LFO output at the period start
+        alignas(64) float lfoEnd[VOICE_BANK_SIZE] = {};               // LFO output at the period end
+        alignas(64) float ladderAlphaStart[VOICE_BANK_SIZE] = {};     // Ladder one-pole coefficient at the start
+        alignas(64) float ladderAlphaEnd[VOICE_BANK_SIZE] = {};       // Ladder one-pole coefficient at the end
+        alignas(64) float ladderResonanceStart[VOICE_BANK_SIZE] = {}; // Ladder feedback amount at the start
+        alignas(64) float ladderResonanceEnd[VOICE_BANK_SIZE] = {};   // Ladder feedback amount at the end
+
+        // Envelopes
+        EnvelopeBank ampEnv;                          // Amplitude envelope
+        EnvelopeBank filterEnv;                       // Filter envelope
+        alignas(64) float gate[VOICE_BANK_SIZE] = {}; // 1.0f for active lanes, 0.0f otherwise
+
+        // Copy one voice's lanes to another slot; must cover every field above
+        void copyVoice(int from, int to) {
+            for (float *lane : {phase, phaseIncrement, subPhase, subPhaseIncrement, osc2Phase, osc2PhaseIncrement,
+                                lfoPhase, filterStates[0], filterStates[1], filterStates[2], filterStates[3], dcState,
+                                lfoStart, lfoEnd, ladderAlphaStart, ladderAlphaEnd, ladderResonanceStart,
+                                ladderResonanceEnd, gate}) {
+                lane[to] = lane[from];
+            }
+            ampEnv.copyVoice(from, to);
+            filterEnv.copyVoice(from, to);
+        }
+};
+
+// Per-lane coefficients for one batch, gathered by the processor in scalar code. Each row holds one
+// value per lane and is sized for the widest kernel; narrower kernels read the first `width` lanes.
+// Inactive lanes and unused unison slots carry zero gain so they stay silent.
+struct BatchSetup {
+        alignas(64) float detune[maxUnison][MAX_SIMD_WIDTH];
+        alignas(64) float unisonPhase[maxUnison][MAX_SIMD_WIDTH];
+        alignas(64) float unisonL[maxUnison][MAX_SIMD_WIDTH];
+        alignas(64) float unisonR[maxUnison][MAX_SIMD_WIDTH];
+        alignas(64) float mainMix[MAX_SIMD_WIDTH];
+        alignas(64) float subMix[MAX_SIMD_WIDTH];
+        alignas(64) float osc2Mix[MAX_SIMD_WIDTH];
+        alignas(64) float lfoDepth[MAX_SIMD_WIDTH];
+        alignas(64) float lfoPitch[MAX_SIMD_WIDTH];
+        alignas(64) float amp[MAX_SIMD_WIDTH];     // Amplitude (envelope times velocity) at the sub-block start
+        alignas(64) float ampStep[MAX_SIMD_WIDTH]; // Per-sample amplitude increment
+        alignas(64) float leftGain[MAX_SIMD_WIDTH];
+        alignas(64) float rightGain[MAX_SIMD_WIDTH];
+        const float *tables[MAX_SIMD_WIDTH];     // Main oscillator mip level per lane
+        const float *osc2Tables[MAX_SIMD_WIDTH]; // Second oscillator mip level per lane
+        int unison = 1;                          // Highest unison count in the batch
+#if SIMDSYNTH_PROFILING
+        ProfileCounters *profile = nullptr; // Where renderBatch times its oscillators and filter, or null
+#endif
+};
+
+// One instruction set's build of the voice kernels
+struct KernelTable {
+        const char *name; // "scalar", "sse4.1", "avx2", "avx512" or "neon"
+        int width;        // Voices per batch
+
+        // Advance one envelope bank by a tick across lanes [begin, end), both multiples of width
+        void (*tickEnvelopes)(EnvelopeBank &env, const float *gate, int begin, int end);
+
+        // lfoEnd = sin(lfoPhase) across lanes [begin, end), and the ladder prewarp angles in `prewarp` replaced
+        // by their (clamped) tangents
+        void (*controlRate)(VoiceLanes &lanes, float *prewarp, int begin, int end);
+
+        // Render `width` voices from voiceOffset over numSamples and accumulate them into mixL/mixR
+        void (*renderBatch)(VoiceLanes &lanes, int voiceOffset, const BatchSetup &setup, int numSamples,
+                            bool filterBypassed, float dcAlpha, const float *filterMix, float *mixL, float *mixR);
+};
+
+// The kernels for this CPU: the widest instruction set it supports, unless the SIMDSYNTH_ISA environment
+// variable names another supported one. Chosen once, on first use.
+const KernelTable &selectKernels();
@@ -0,0 +1,16 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// VoiceKernelsAvx2.cpp - Voice kernels for AVX2 and FMA, eight lanes. Built with -mavx2 -mfma.
+
+#include "VoiceKernelsImpl.h"
+
+#if defined(__AVX2__) && defined(__FMA__)
+extern const KernelTable avx2Kernels;
+const KernelTable avx2Kernels = voicekernels::makeKernelTable<simd::Vec<simd::Avx2>>("avx2");
+#endif
@@ -0,0 +1,16 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// VoiceKernelsAvx512.cpp - Voice kernels for AVX-512F, sixteen lanes. Built with -mavx512f.
+
+#include "VoiceKernelsImpl.h"
+
+#if defined(__AVX512F__)
+extern const KernelTable avx512Kernels;
+const KernelTable avx512Kernels = voicekernels::makeKernelTable<simd::Vec<simd::Avx512>>("avx512");
+#endif
@@ -0,0 +1,243 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// VoiceKernelsImpl.h - The voice kernels, written once against simd::Vec and instantiated by each
+// VoiceKernels<Isa>.cpp with that translation unit's ISA flags. Only include it from those files, or
+// instantiate it for the scalar and baseline backends only, as the benchmarks do. The kernels stay clear
+// of std:: and JUCE helpers: an inline function instantiated here would be compiled with the wider ISA and
+// could be picked by the linker for callers on CPUs that lack it.
+#pragma once
+
+#include "SimdMath.h"
+#include "VoiceKernels.h"
+
+namespace voicekernels {
+
+// Wavetable lookup for a batch of voices, each lane reading from its own table. Index and fraction
+// math is vectorised; the table reads themselves are a per-lane gather.
+template <typename V>
+inline V lookup(V phase, const float *const *tables) {
+    phase = phase - simd::floor(phase); // Normalize to [0, 1]
+    const V index = phase * V::set1(static_cast<float>(WAVETABLE_SIZE - 1));
+    const V indexFloor = simd::floor(index);
+    alignas(64) float tempIndices[V::width], tempLo[V::width], tempHi[V::width];
+    indexFloor.store(tempIndices);
+    for (int i = 0; i < V::width; ++i) {
+        // Clamp index to prevent out-of-bounds access
+        int idx = static_cast<int>(tempIndices[i]);
+        idx = idx < 0 ? 0 : (idx > WAVETABLE_SIZE - 2 ? WAVETABLE_SIZE - 2 : idx);
+        tempLo[i] = tables[i][idx];
+        tempHi[i] = tables[i][idx + 1];
+    }
+    const V lo = V::load(tempLo);
+    return lo + (index - indexFloor) * (V::load(tempHi) - lo); // Linear interpolation
+}
+
+// Run one batch of voices through the ladder filter for a whole sub-block. Input and output are
+// interleaved as [sample][lane]; cutoff and resonance ramp between the control-rate values.
+template <typename V>
+inline void ladder(VoiceLanes &lanes, int voiceOffset, const float *input, float *output, int numSamples) {
+    // Coefficient ramps from the control-rate stage
+    const V invNumSamples = V::set1(1.0f / static_cast<float>(numSamples));
+    V alpha = V::load(lanes.ladderAlphaStart + voiceOffset);
+    V resonance = V::load(lanes.ladderResonanceStart + voiceOffset);
+    const V alphaStep = (V::load(lanes.ladderAlphaEnd + voiceOffset) - alpha) * invNumSamples;
+    const V resonanceStep = (V::load(lanes.ladderResonanceEnd + voiceOffset) - resonance) * invNumSamples;
+
+    // Load the filter states straight from the voice lanes; the gate zeroes inactive lanes
+    const V gate = V::load(lanes.gate + voiceOffset);
+    V s0 = V::load(lanes.filterStates[0] + voiceOffset) * gate;
+    V s1 = V::load(lanes.filterStates[1] + voiceOffset) * gate;
+    V s2 = V::load(lanes.filterStates[2] + voiceOffset) * gate;
+    V s3 = V::load(lanes.filterStates[3] + voiceOffset) * gate;
+
+    const V minusOne = V::set1(-1.0f);
+    const V one = V::set1(1.0f);
+    for (int n = 0; n < numSamples; n++) {
+        alpha = alpha + alphaStep;
+        resonance = resonance + resonanceStep;
+
+        // Apply filter with clipping
+        const V filterInput = V::load(input + n * V::width) - s3 * resonance;
+        s0 = simd::max(minusOne, simd::min(s0 + alpha * (filterInput - s0), one));
+        s1 = simd::max(minusOne, simd::min(s1 + alpha * (s0 - s1), one));
+        s2 = simd::max(minusOne, simd::min(s2 + alpha * (s1 - s2), one));
+        s3 = simd::max(minusOne, simd::min(s3 + alpha * (s2 - s3), one));
+
+        // Apply cubic soft clipping: x - x^3 / 3 on the clamped last stage
+        (simdmath::softclip_ps(s3) * gate).store(output + n * V::width);
+    }
+
+    // Store states
+    (s0 * gate).store(lanes.filterStates[0] + voiceOffset);
+    (s1 * gate).store(lanes.filterStates[1] + voiceOffset);
+    (s2 * gate).store(lanes.filterStates[2] + voiceOffset);
+    (s3 * gate).store(lanes.filterStates[3] + voiceOffset);
+}
+
+// One multiply-add per batch: value = clamp(value * mul + add) * gate
+template <typename V>
+void tickEnvelopes(EnvelopeBank &env, const float *gate, int begin, int end) {
+    const V zero = V::set1(0.0f);
+    const V one = V::set1(1.0f);
+    for (int offset = begin; offset < end; offset += V::width) {
+        const V value = simd::fmadd(V::load(env.value + offset), V::load(env.mul + offset), V::load(env.add + offset));
+        (simd::max(zero, simd::min(value, one)) * V::load(gate + offset)).store(env.value + offset);
+    }
+}
+
+// One LFO sine and one prewarp tangent per batch and control period
+template <typename V>
+void controlRate(VoiceLanes &lanes, float *prewarp, int begin, int end) {
+    const V maxAlpha = V::set1(10.0f);
+    for (int offset = begin; offset < end; offset += V::width) {
+        simdmath::sin_ps(V::load(lanes.lfoPhase + offset)).store(lanes.lfoEnd + offset);
+        simd::min(simdmath::tan_ps(V::load(prewarp + offset)), maxAlpha).store(prewarp + offset);
+    }
+}
+
+#if SIMDSYNTH_PROFILING
+// Oscillators from `oscillatorStart`, the filter from `filterStart` until now
+static inline void chargeBatch(ProfileCounters *profile, uint64_t oscillatorStart, uint64_t filterStart) {
+    if (profile == nullptr) return;
+    profile->ticks[StageOscillators] += filterStart - oscillatorStart;
+    profile->ticks[StageFilter] += profileClock() - filterStart;
+}
+#endif
+
+// Render one batch of voices over a sub-block and accumulate it into mixL/mixR: oscillators, ladder
+// filter and DC blocker all run across the batch with the state held in SIMD registers.
+template <typename V>
+void renderBatch(VoiceLanes &lanes, int voiceOffset, const BatchSetup &setup, int numSamples, bool filterBypassed,
+                 float dcAlpha, const float *filterMix, float *mixL, float *mixR) {
+    // Plain clock reads, no timer: a branch here would change how the compiler fuses the arithmetic below
+    SIMDSYNTH_PROFILE_ONLY(const uint64_t oscillatorStart = profileClock());
+    alignas(64) float batchCombined[RENDER_SUB_BLOCK][V::width];
+    alignas(64) float batchDryL[RENDER_SUB_BLOCK][V::width];
+    alignas(64) float batchDryR[RENDER_SUB_BLOCK][V::width];
+
+    const V one = V::set1(1.0f);
+    const V half = V::set1(0.5f);
+    const V two = V::set1(2.0f);
+    const V twoPi = V::set1(simdmath::twoPi);
+    const V invTwoPi = V::set1(1.0f / simdmath::twoPi);
+    const int batchUnison = setup.unison;
+    V detune[maxUnison], unisonPhase[maxUnison], unisonL[maxUnison], unisonR[maxUnison];
+    for (int u = 0; u < batchUnison; ++u) {
+        detune[u] = V::load(setup.detune[u]);
+        unisonPhase[u] = V::load(setup.unisonPhase[u]);
+        unisonL[u] = V::load(setup.unisonL[u]);
+        unisonR[u] = V::load(setup.unisonR[u]);
+    }
+    const V mainMix = V::load(setup.mainMix);
+    const V subMix = V::load(setup.subMix);
+    const V osc2Mix = V::load(setup.osc2Mix);
+    const V lfoDepth = V::load(setup.lfoDepth);
+    const V lfoPitch = V::load(setup.lfoPitch);
+    const V increment = V::load(lanes.phaseIncrement + voiceOffset);
+    const V subIncrement = V::load(lanes.subPhaseIncrement + voiceOffset);
+    const V osc2Increment = V::load(lanes.osc2PhaseIncrement + voiceOffset);
+    const V ampStep = V::load(setup.ampStep);
+    V amp = V::load(setup.amp);
+
+    // The LFO ramps between the values the control-rate stage computed for this period
+    V lfo = V::load(lanes.lfoStart + voiceOffset);
+    const V lfoStep = (V::load(lanes.lfoEnd + voiceOffset) - lfo) * V::set1(1.0f / static_cast<float>(numSamples));
+
+    V phase = V::load(lanes.phase + voiceOffset);
+    V subPhase = V::load(lanes.subPhase + voiceOffset);
+    V osc2Phase = V::load(lanes.osc2Phase + voiceOffset);
+
+    for (int n = 0; n < numSamples; ++n) {
+        amp = amp + ampStep;
+
+        lfo = lfo + lfoStep;
+        const V lfoVal = lfo * lfoDepth;
+        const V phaseModCycles = lfoVal * invTwoPi;
+        const V phaseModRadians = phaseModCycles * twoPi;
+
+        // Unison main oscillators
+        V unisonOutputL = V::set1(0.0f), unisonOutputR = V::set1(0.0f);
+        const V modulatedPhase = phase + phaseModCycles;
+        for (int u = 0; u < batchUnison; ++u) {
+            const V mainVal = lookup((modulatedPhase + unisonPhase[u]) * detune[u], setup.tables);
+            unisonOutputL = simd::fmadd(mainVal, unisonL[u], unisonOutputL);
+            unisonOutputR = simd::fmadd(mainVal, unisonR[u], unisonOutputR);
+        }
+        const V mainGain = amp * mainMix;
+        unisonOutputL = unisonOutputL * mainGain;
+        unisonOutputR = unisonOutputR * mainGain;
+
+        const V filteredSub = simdmath::sin_ps(subPhase + phaseModRadians) * (amp * subMix);
+        const V osc2Val = lookup((osc2Phase + phaseModRadians) * invTwoPi, setup.osc2Tables);
+        const V filteredOsc2 = osc2Val * (amp * osc2Mix);
+
+        const V subAndOsc2 = filteredSub + filteredOsc2;
+        const V unisonMono = (unisonOutputL + unisonOutputR) * half;
+        ((unisonMono + subAndOsc2) * two).store(batchCombined[n]);
+        (unisonOutputL + subAndOsc2).store(batchDryL[n]);
+        (unisonOutputR + subAndOsc2).store(batchDryR[n]);
+
+        // Advance and wrap the phases
+        phase = phase + increment * simd::fmadd(lfoVal, lfoPitch, one);
+        phase = phase - simd::floor(phase);
+        subPhase = subPhase + subIncrement;
+        subPhase = subPhase - simd::floor(subPhase * invTwoPi) * twoPi;
+        osc2Phase = osc2Phase + osc2Increment;
+        osc2Phase = osc2Phase - simd::floor(osc2Phase * invTwoPi) * twoPi;
+    }
+
+    phase.store(lanes.phase + voiceOffset);
+    subPhase.store(lanes.subPhase + voiceOffset);
+    osc2Phase.store(lanes.osc2Phase + voiceOffset);
+    SIMDSYNTH_PROFILE_ONLY(const uint64_t filterStart = profileClock());
+
+    // Pan; inactive lanes have zero gain
+    const V leftGain = V::load(setup.leftGain);
+    const V rightGain = V::load(setup.rightGain);
+
+    if (filterBypassed) {
+        for (int n = 0; n < numSamples; ++n) {
+            mixL[n] += simdmath::sum(V::load(batchDryL[n]) * leftGain);
+            mixR[n] += simdmath::sum(V::load(batchDryR[n]) * rightGain);
+        }
+        SIMDSYNTH_PROFILE_ONLY(chargeBatch(setup.profile, oscillatorStart, filterStart));
+        return;
+    }
+
+    alignas(64) float filtered[RENDER_SUB_BLOCK][V::width];
+    ladder<V>(lanes, voiceOffset, batchCombined[0], filtered[0], numSamples);
+
+    const V alphaDC = V::set1(dcAlpha);
+    const V gate = V::load(lanes.gate + voiceOffset);
+    V dcState = V::load(lanes.dcState + voiceOffset);
+    for (int n = 0; n < numSamples; ++n) {
+        dcState = (V::load(filtered[n]) - alphaDC * dcState) * gate;
+        dcState.store(filtered[n]);
+    }
+    dcState.store(lanes.dcState + voiceOffset);
+
+    // Saturate and blend with the dry signal
+    const V drive = V::set1(0.8f);
+    for (int n = 0; n < numSamples; ++n) {
+        const V dryGain = V::set1(1.0f - filterMix[n]);
+        const V wet = simdmath::tanh_ps(V::load(filtered[n]) * drive) * V::set1(filterMix[n]);
+        const V outL = simd::fmadd(V::load(batchDryL[n]), dryGain, wet);
+        const V outR = simd::fmadd(V::load(batchDryR[n]), dryGain, wet);
+        mixL[n] += simdmath::sum(outL * leftGain);
+        mixR[n] += simdmath::sum(outR * rightGain);
+    }
+    SIMDSYNTH_PROFILE_ONLY(chargeBatch(setup.profile, oscillatorStart, filterStart));
+}
+
+template <typename V>
+constexpr KernelTable makeKernelTable(const char *name) {
+    return {name, V::width, &tickEnvelopes<V>, &controlRate<V>, &renderBatch<V>};
+}
+
+} // namespace voicekernels
@@ -0,0 +1,16 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// VoiceKernelsNeon.cpp - Voice kernels for NEON, four lanes.
+
+#include "VoiceKernelsImpl.h"
+
+#if defined(__aarch64__) || defined(__arm64__)
+extern const KernelTable neonKernels;
+const KernelTable neonKernels = voicekernels::makeKernelTable<simd::Vec<simd::Neon>>("neon");
+#endif
@@ -0,0 +1,14 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// VoiceKernelsScalar.cpp - Voice kernels at one lane, built with the baseline flags. Always available.
+
+#include "VoiceKernelsImpl.h"
+
+extern const KernelTable scalarKernels;
+const KernelTable scalarKernels = voicekernels::makeKernelTable<simd::Vec<simd::Scalar>>("scalar");
@@ -0,0 +1,16 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// VoiceKernelsSse41.cpp - Voice kernels for SSE4.1, four lanes.
+
+#include "VoiceKernelsImpl.h"
+
+#if defined(__SSE4_1__)
+extern const KernelTable sse41Kernels;
+const KernelTable sse41Kernels = voicekernels::makeKernelTable<simd::Vec<simd::Sse41>>("sse4.1");
+#endif
@@ -0,0 +1,23 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// WavetableData.h - Tables generated at build time by simdsynth-wavetablegen into WavetableData.cpp in the
+// build directory: the base sine cycle and the saw and square mips for the most common host rates.
+#pragma once
+
+#include "Wavetables.h"
+
+// A generated set of mips, laid out as Wavetables::buildHarmonicTables fills them
+struct GeneratedWavetables {
+        double sampleRate;
+        const float *tables; // NUM_HARMONIC_TABLES * WAVETABLE_SIZE samples
+};
+
+extern const float GENERATED_SINE[WAVETABLE_SIZE];
+extern const GeneratedWavetables GENERATED_WAVETABLES[];
+extern const int NUM_GENERATED_WAVETABLES;
@@ -0,0 +1,115 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+#include "Wavetables.h"
+#include "SimdMath.h"
+#if !SIMDSYNTH_WAVETABLE_GEN
+#include "WavetableData.h"
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+
+std::shared_ptr<const Wavetables> Wavetables::acquire(double hostSampleRate) {
+    static std::mutex sharedMutex;
+    static std::map<double, std::weak_ptr<const Wavetables>> shared; // By host rate
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    std::shared_ptr<const Wavetables> tables = shared[hostSampleRate].lock();
+    if (tables == nullptr) {
+        // Drop the rates nobody uses any more before adding this one
+        for (auto it = shared.begin(); it != shared.end();) {
+            it = it->second.expired() ? shared.erase(it) : std::next(it);
+        }
+        tables = std::make_shared<const Wavetables>(hostSampleRate);
+        shared[hostSampleRate] = tables;
+    }
+    return tables;
+}
+
+#if SIMDSYNTH_WAVETABLE_GEN
+// Building the generator itself: compute the sine here; everything else reads the generated copy
+const float *Wavetables::getSine() {
+    static const std::vector<float> sine = [] {
+        std::vector<float> table(WAVETABLE_SIZE);
+        for (int i = 0; i < WAVETABLE_SIZE; ++i) {
+            float phase = (float)i / (float)(WAVETABLE_SIZE - 1) * simdmath::twoPi;
+            table[i] = std::sin(phase);
+        }
+        return table;
+    }();
+    return sine.data();
+}
+#else
+const float *Wavetables::getSine() { return GENERATED_SINE; }
+#endif
+
+Wavetables::Wavetables(double hostSampleRate) : sampleRate(hostSampleRate) {
+#if !SIMDSYNTH_WAVETABLE_GEN
+    for (int i = 0; i < NUM_GENERATED_WAVETABLES; ++i) {
+        if (GENERATED_WAVETABLES[i].sampleRate == hostSampleRate) {
+            harmonicTables = GENERATED_WAVETABLES[i].tables;
+            return;
+        }
+    }
+#endif
+    built.resize(static_cast<size_t>(NUM_HARMONIC_TABLES * WAVETABLE_SIZE));
+    buildHarmonicTables(hostSampleRate, built.data());
+    harmonicTables = built.data();
+}
+
+// Per-octave band-limited tables for the host sample rate. Level k serves fundamentals up to
+// WAVETABLE_MIP_BASE_FREQ * 2^(k + 1) and carries every harmonic below min(20 kHz, 0.45 * host rate),
+// so high notes do not alias and low notes keep their top end. Harmonics are read from the base sine
+// cycle at integer multiples of the index. Every level of the sine is the base cycle itself.
+void Wavetables::buildHarmonicTables(double hostSampleRate, float *tables) {
+    const float *sine = getSine();
+    const float maxHarmonicFreq = std::min(20000.0f, 0.45f * static_cast<float>(hostSampleRate));
+    const int period = WAVETABLE_SIZE - 1; // One cycle spans WAVETABLE_SIZE - 1 steps plus a guard sample
+
+    for (int octave = 0; octave < NUM_WAVETABLE_OCTAVES; ++octave) {
+        const float topFrequency = WAVETABLE_MIP_BASE_FREQ * static_cast<float>(1 << (octave + 1));
+        const int maxHarmonics = std::max(1, static_cast<int>(maxHarmonicFreq / topFrequency));
+        float *saw = tables + (octave * 2) * WAVETABLE_SIZE;
+        float *square = tables + (octave * 2 + 1) * WAVETABLE_SIZE;
+        std::fill(saw, saw + WAVETABLE_SIZE, 0.0f);
+        std::fill(square, square + WAVETABLE_SIZE, 0.0f);
+
+        for (int harmonic = 1; harmonic <= maxHarmonics; ++harmonic) {
+            const float amp = 1.0f / harmonic;
+            const bool odd = harmonic % 2 == 1;
+            for (int i = 0; i < WAVETABLE_SIZE; ++i) {
+                const float s = sine[(harmonic * i) % period];
+                saw[i] += amp * s;
+                if (odd) square[i] += amp * s;
+            }
+        }
+
+        // Normalize to [-1, 1]
+        for (float *table : {saw, square}) {
+            float peak = 0.0f;
+            for (int i = 0; i < WAVETABLE_SIZE; ++i) peak = std::max(peak, std::abs(table[i]));
+            if (peak > 0.0f) {
+                for (int i = 0; i < WAVETABLE_SIZE; ++i) table[i] /= peak;
+            }
+        }
+    }
+}
+
+// Select the band-limited table for a waveform index and fundamental frequency (Hz)
+const float *Wavetables::get(int wavetableType, float frequency) const {
+    int level = 0;
+    if (frequency > WAVETABLE_MIP_BASE_FREQ) {
+        level = std::clamp(static_cast<int>(std::log2(frequency / WAVETABLE_MIP_BASE_FREQ)), 0,
+                           NUM_WAVETABLE_OCTAVES - 1);
+    }
+    const int type = (wavetableType >= 0 && wavetableType < NUM_WAVEFORMS) ? wavetableType : 0;
+    if (type == 0) return getSine();
+    return harmonicTables + (level * 2 + type - 1) * WAVETABLE_SIZE;
+}
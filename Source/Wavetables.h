@@ -0,0 +1,45 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// Wavetables.h - The oscillators' band-limited tables. They depend only on the host sample rate, so each set is
+// built once per process and shared read-only by every engine running at that rate; a session full of instances
+// pays for one set and the instances read the same cache lines. The base sine and the sets for the common rates
+// are generated at build time by simdsynth-wavetablegen (Tools/WavetableGen.cpp) and cost nothing at startup.
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "VoiceKernels.h" // WAVETABLE_SIZE
+
+static constexpr int NUM_WAVETABLE_OCTAVES = 10;        // Band-limited mip levels, one per octave
+static constexpr float WAVETABLE_MIP_BASE_FREQ = 20.0f; // Lowest mip level covers fundamentals up to 40 Hz
+static constexpr int NUM_WAVEFORMS = 3;                 // Sine, saw, square
+static constexpr int NUM_HARMONIC_TABLES = NUM_WAVETABLE_OCTAVES * (NUM_WAVEFORMS - 1); // Saw and square mips
+
+class Wavetables {
+    public:
+        // The tables for `hostSampleRate`, built on first use and freed when the last engine holding them lets
+        // go. Not for the audio thread: the first call for a rate builds the set.
+        static std::shared_ptr<const Wavetables> acquire(double hostSampleRate);
+
+        // One cycle of a sine, WAVETABLE_SIZE samples with a guard sample
+        static const float *getSine();
+
+        // Fill `tables` with the saw and square mips for a rate, NUM_HARMONIC_TABLES tables of WAVETABLE_SIZE
+        static void buildHarmonicTables(double hostSampleRate, float *tables);
+
+        explicit Wavetables(double hostSampleRate); // Uses the generated set for the rate if there is one
+
+        const float *get(int wavetableType, float frequency) const; // Mip level for a note, frequency in Hz
+        double getSampleRate() const { return sampleRate; }
+
+    private:
+        double sampleRate;
+        std::vector<float> built;              // Mips built at runtime, for a rate without a generated set
+        const float *harmonicTables = nullptr; // [octave * 2 + waveform - 1][WAVETABLE_SIZE]; sine is getSine()
+};
@@ -0,0 +1,200 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Busy-wait hint for spin loops
+static inline void cpuRelax() {
+#if defined(__x86_64__) || defined(_M_X64)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// Wait for another thread to finish something short; yields after a while in case that thread is not running
+template <typename Condition>
+static void spinUntil(Condition done) {
+    for (int spins = 0; !done(); ++spins) {
+        if (spins < 1000)
+            cpuRelax();
+        else
+            std::this_thread::yield();
+    }
+}
+
+// How long an idle worker stays awake after its last job or dispatch: longer than the block period at the usual
+// buffer sizes, so while audio runs the workers are awake at every dispatch and the audio thread never has to
+// wake one (a system call). Workers only sleep once dispatches stop.
+static constexpr auto IDLE_LINGER = std::chrono::milliseconds(50);
+
+// Real-time (SCHED_FIFO) priority a little below the host's audio thread, and optionally one fixed CPU.
+// Either can fail without privileges; the worker then runs with the default policy.
+static void configureWorkerThread(std::thread &thread, int cpu) {
+#if defined(__unix__) || defined(__APPLE__)
+    sched_param param{};
+    param.sched_priority = std::max(sched_get_priority_min(SCHED_FIFO), sched_get_priority_max(SCHED_FIFO) - 10);
+    pthread_setschedparam(thread.native_handle(), SCHED_FIFO, &param);
+#endif
+#if defined(__linux__)
+    if (cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu % std::max(1u, std::thread::hardware_concurrency()), &cpus);
+        pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus);
+    }
+#else
+    (void)cpu;
+#endif
+}
+
+std::shared_ptr<WorkerPool> WorkerPool::acquire() {
+    // SIMDSYNTH_WORKERS is a thread count, or "auto" for one per core but the host's audio thread
+    const int maxWorkers = std::min(static_cast<int>(std::thread::hardware_concurrency()) - 1, MAX_WORKERS);
+    const char *workersSetting = std::getenv("SIMDSYNTH_WORKERS");
+    if (workersSetting == nullptr) return nullptr;
+    const int numWorkers =
+        std::strcmp(workersSetting, "auto") == 0 ? maxWorkers : std::min(std::atoi(workersSetting), maxWorkers);
+    if (numWorkers <= 0) return nullptr;
+
+    static std::mutex sharedMutex;
+    static std::weak_ptr<WorkerPool> shared;
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    std::shared_ptr<WorkerPool> pool = shared.lock();
+    if (pool == nullptr) {
+        const char *pinSetting = std::getenv("SIMDSYNTH_PIN_WORKERS");
+        pool = std::make_shared<WorkerPool>(numWorkers, pinSetting != nullptr && std::strcmp(pinSetting, "1") == 0);
+        shared = pool;
+    }
+    return pool;
+}
+
+WorkerPool::WorkerPool(int numWorkers, bool pinWorkers) {
+    numWorkers = std::clamp(numWorkers, 0, MAX_WORKERS);
+    workers.reserve(static_cast<size_t>(numWorkers));
+    for (int i = 0; i < numWorkers; ++i) {
+        workers.emplace_back([this, i] { workerLoop(i); });
+        configureWorkerThread(workers.back(), pinWorkers ? i + 1 : -1);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping.store(true);
+    }
+    wakeCondition.notify_all();
+    for (std::thread &worker : workers) worker.join();
+}
+
+bool WorkerPool::runJobs(JobGroup &group) {
+    bool ranAny = false;
+    for (;;) {
+        const int index = group.next.fetch_add(1, std::memory_order_acq_rel);
+        if (index >= group.count) return ranAny;
+        group.function(group.context, index);
+        group.completed.fetch_add(1, std::memory_order_release);
+        ranAny = true;
+    }
+}
+
+void WorkerPool::run(JobGroup &group, void (*function)(void *context, int index), void *context, int count) {
+    group.function = function;
+    group.context = context;
+    group.count = count;
+    group.completed.store(0, std::memory_order_relaxed);
+    group.next.store(0, std::memory_order_release);
+
+    // Publish the group; without a free slot the caller simply runs every job itself
+    int slot = -1;
+    for (int s = 0; s < MAX_GROUPS && slot < 0; ++s) {
+        JobGroup *expected = nullptr;
+        if (published[s].compare_exchange_strong(expected, &group)) slot = s;
+    }
+    if (slot >= 0) {
+        wakeCount.fetch_add(1);
+        if (sleepers.load() > 0) wakeCondition.notify_all();
+    }
+
+    runJobs(group);
+    if (slot >= 0) published[slot].store(nullptr);
+
+    // Wait for the jobs the workers claimed, then until no worker still looks at the group, so it can be
+    // rearmed or destroyed as soon as run returns
+    spinUntil([&] { return group.completed.load(std::memory_order_acquire) >= count; });
+    for (int w = 0; w < getNumWorkers(); ++w) {
+        spinUntil([&] { return hazards[w].load() != &group; });
+    }
+}
+
+// A group is only touched after it has been announced in hazards[index] and found still published; run()
+// waits for the announcement to clear before the group can change
+bool WorkerPool::runPublishedJobs(int index) {
+    bool ranAny = false;
+    for (int i = 0; i < MAX_GROUPS; ++i) {
+        const int s = (i + index) % MAX_GROUPS; // Workers start their scan at different slots
+        JobGroup *group = published[s].load();
+        if (group == nullptr) continue;
+        hazards[index].store(group);
+        if (published[s].load() == group) ranAny |= runJobs(*group);
+        hazards[index].store(nullptr);
+    }
+    return ranAny;
+}
+
+void WorkerPool::workerLoop(int index) {
+    uint32_t seenWakeCount = wakeCount.load();
+    int idleSpins = 0;
+    std::chrono::steady_clock::time_point idleSince;
+    while (!stopping.load(std::memory_order_relaxed)) {
+        if (runPublishedJobs(index)) {
+            idleSpins = 0;
+            continue;
+        }
+        if (wakeCount.load() != seenWakeCount) {
+            seenWakeCount = wakeCount.load();
+            idleSpins = 0;
+            continue;
+        }
+
+        // Spin briefly, since a block dispatches its chunks in quick succession, then yield until the next
+        // block is due, and sleep only after IDLE_LINGER without work. The timeout bounds a wake-up missed
+        // between the last check and the wait.
+        if (idleSpins < 2000) {
+            ++idleSpins;
+            cpuRelax();
+            continue;
+        }
+        if (idleSpins == 2000) {
+            ++idleSpins;
+            idleSince = std::chrono::steady_clock::now();
+        }
+        if (std::chrono::steady_clock::now() - idleSince < IDLE_LINGER) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepers.fetch_add(1);
+        wakeCondition.wait_for(lock, std::chrono::milliseconds(1),
+                               [&] { return stopping.load() || wakeCount.load() != seenWakeCount; });
+        sleepers.fetch_sub(1);
+    }
+}
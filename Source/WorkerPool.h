@@ -0,0 +1,71 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// WorkerPool.h - A process-wide pool of audio worker threads, shared by every engine in the process so that
+// several plugin instances never start more threads than there are cores. A caller publishes a group of
+// independent jobs, works on it itself, and the idle workers claim jobs from it through the group's one shared
+// atomic counter (there are no per-thread queues). No locks are taken on the audio path, and workers stay awake
+// between blocks, so a dispatch while audio runs makes no system call.
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkerPool {
+    public:
+        // A set of jobs dispatched together. Owned by the caller and reused for every dispatch; one
+        // dispatch at a time per group.
+        class JobGroup {
+            private:
+                friend class WorkerPool;
+                void (*function)(void *context, int index) = nullptr;
+                void *context = nullptr;
+                int count = 0;
+                std::atomic<int> next{0};      // Next unclaimed job
+                std::atomic<int> completed{0}; // Jobs finished
+        };
+
+        // The shared pool, started on first use and stopped when the last user releases it. Returns null
+        // unless the SIMDSYNTH_WORKERS environment variable asks for worker threads (a count, or "auto" for
+        // one per core but one), capped at one fewer than the cores; SIMDSYNTH_PIN_WORKERS=1 also pins
+        // worker i to CPU i + 1 (Linux).
+        static std::shared_ptr<WorkerPool> acquire();
+
+        WorkerPool(int numWorkers, bool pinWorkers);
+        ~WorkerPool();
+
+        int getNumWorkers() const { return static_cast<int>(workers.size()); }
+
+        // Run function(context, i) for every i in [0, count) on the workers and the calling thread, and return
+        // when all have finished. Jobs must be independent of each other; which thread runs which job is not
+        // fixed, so each job should write its own output.
+        void run(JobGroup &group, void (*function)(void *context, int index), void *context, int count);
+
+    private:
+        static constexpr int MAX_GROUPS = 64; // Dispatches in flight at once, across all engines
+        static constexpr int MAX_WORKERS = 64;
+
+        void workerLoop(int index);
+        bool runPublishedJobs(int index); // One pass over the published groups; true if a job was run
+        static bool runJobs(JobGroup &group); // Claim and run jobs until none are left; true if any ran
+
+        std::atomic<JobGroup *> published[MAX_GROUPS] = {}; // Groups with jobs left to claim
+        std::atomic<JobGroup *> hazards[MAX_WORKERS] = {};  // Group each worker is looking at
+
+        std::vector<std::thread> workers;
+        std::atomic<bool> stopping{false};
+        std::atomic<uint32_t> wakeCount{0};
+        std::atomic<int> sleepers{0};
+        std::mutex sleepMutex;
+        std::condition_variable wakeCondition;
+};
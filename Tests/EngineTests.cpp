@@ -0,0 +1,56 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// EngineTests.cpp - simdsynth-enginetests: checks that refreshing the pitch of sounding voices keeps their main
+// oscillator where noteOn put it, at host rates below 44.1 kHz too. Two engines play the same note with the sub
+// and second oscillators muted; one has its sub tuning moved mid-note, which refreshes every voice's pitch, and
+// their outputs must stay identical. Exits non-zero on any difference.
+
+#include "SynthEngine.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+static constexpr int BLOCK = 512;
+static constexpr int BLOCKS = 64;
+
+// Render BLOCKS blocks of one held note, moving the sub tuning after the first block when `retune` is set
+static std::vector<float> renderNote(double hostSampleRate, bool retune) {
+    SynthParams params;
+    params.subMix = 0.0f;
+    params.osc2Mix = 0.0f;
+    params.filterBypass = true;
+
+    SynthEngine engine;
+    engine.prepare(hostSampleRate, 1);
+    engine.setParameters(params, true);
+
+    std::vector<float> output(static_cast<size_t>(BLOCK * BLOCKS));
+    const SynthEvent note{SynthEvent::Type::NoteOn, 0, 69, 0.8f};
+    for (int block = 0; block < BLOCKS; ++block) {
+        if (retune && block == 1) {
+            params.subTune = -7.0f;
+            engine.setParameters(params, true);
+        }
+        engine.render(&note, block == 0 ? 1 : 0, output.data() + block * BLOCK, nullptr, BLOCK);
+    }
+    return output;
+}
+
+int main() {
+    int failures = 0;
+    for (double rate : {48000.0, 32000.0, 22050.0, 8000.0}) {
+        const std::vector<float> reference = renderNote(rate, false);
+        const std::vector<float> retuned = renderNote(rate, true);
+        const bool passed = std::memcmp(reference.data(), retuned.data(), reference.size() * sizeof(float)) == 0;
+        failures += passed ? 0 : 1;
+        std::printf("%.0f Hz: main oscillator after a pitch refresh  %s\n", rate, passed ? "ok" : "FAILED");
+    }
+    return failures == 0 ? 0 : 1;
+}
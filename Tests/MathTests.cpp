@@ -0,0 +1,118 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// MathTests.cpp - simdsynth-mathtests: sweeps the SimdMath functions over their documented domains on the scalar
+// backend and on every instruction set the build compiled and the CPU runs, and checks them against libm (in
+// double precision) with the error bounds stated in SimdMath.h. Exits non-zero if any bound is exceeded.
+
+#include "MathTests.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+extern const MathEvaluator avx2Evaluator;
+extern const MathEvaluator avx512Evaluator;
+#endif
+
+static constexpr int SWEEP_POINTS = 1 << 18; // Per domain, a multiple of every vector width
+
+// One documented bound: the largest error allowed over [low, high]
+struct MathCase {
+        MathFunction function;
+        const char *name;
+        float low, high;
+        double maxError;
+        bool relative; // Relative error, otherwise absolute
+};
+
+static const MathCase MATH_CASES[] = {
+    {MathSin, "sin_ps", -10.0f, 10.0f, 4e-6, false},
+    {MathSin, "sin_ps", -99.0f, 99.0f, 1e-5, false},
+    {MathCos, "cos_ps", -10.0f, 10.0f, 4e-6, false},
+    {MathCos, "cos_ps", -99.0f, 99.0f, 1e-5, false},
+    {MathExp2, "exp2_ps", -126.0f, 126.0f, 2.5e-7, true},
+    {MathExp, "exp_ps", -10.0f, 10.0f, 7e-7, true},
+    {MathExp, "exp_ps", -87.0f, 87.0f, 4e-6, true},
+    {MathTan, "tan_ps", -1.2f, 1.2f, 7e-7, true},
+    {MathTan, "tan_ps", -1.45f, 1.45f, 3e-5, true},
+    {MathTanh, "tanh_ps", -20.0f, 20.0f, 1.5e-7, false},
+    {MathSemitonesToRatio, "semitonesToRatio_ps", -48.0f, 48.0f, 4e-7, true},
+    {MathSemitonesToRatio, "semitonesToRatio_ps", -127.0f, 127.0f, 7e-7, true},
+};
+
+static double reference(MathFunction function, double x) {
+    switch (function) {
+    case MathSin: return std::sin(x);
+    case MathCos: return std::cos(x);
+    case MathExp2: return std::exp2(x);
+    case MathExp: return std::exp(x);
+    case MathTan: return std::tan(x);
+    case MathTanh: return std::tanh(x);
+    case MathSemitonesToRatio: return std::exp2(x / 12.0);
+    }
+    return 0.0;
+}
+
+// Arguments and results, aligned for the vector loads
+alignas(64) static float x[SWEEP_POINTS];
+alignas(64) static float y[SWEEP_POINTS];
+
+// Largest error of one backend over a case's domain, both ends included
+static double sweep(MathEvaluator evaluator, const MathCase &test) {
+    for (int i = 0; i < SWEEP_POINTS; ++i) {
+        const double t = static_cast<double>(i) / (SWEEP_POINTS - 1);
+        x[i] = static_cast<float>(test.low + t * (static_cast<double>(test.high) - test.low));
+    }
+    evaluator(test.function, x, y, SWEEP_POINTS);
+
+    double maxError = 0.0;
+    for (int i = 0; i < SWEEP_POINTS; ++i) {
+        const double exact = reference(test.function, x[i]);
+        double error = std::abs(static_cast<double>(y[i]) - exact);
+        if (test.relative) error /= std::abs(exact);
+        if (!(error <= maxError)) maxError = error; // NaN counts as a failure
+    }
+    return maxError;
+}
+
+struct Backend {
+        const char *name;
+        MathEvaluator evaluator;
+        bool supported;
+};
+
+int main() {
+    std::vector<Backend> backends{{"scalar", evaluate<simd::Vec<simd::Scalar>>, true}};
+#if defined(__x86_64__) || defined(_M_X64)
+    __builtin_cpu_init();
+    backends.push_back({"sse4.1", evaluate<simd::Vec<simd::Sse41>>, __builtin_cpu_supports("sse4.1") != 0});
+    backends.push_back({"avx2", avx2Evaluator, __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")});
+    backends.push_back({"avx512", avx512Evaluator, __builtin_cpu_supports("avx512f") != 0});
+#elif defined(__aarch64__) || defined(__arm64__)
+    backends.push_back({"neon", evaluate<simd::Vec<simd::Neon>>, true});
+#endif
+
+    int failures = 0;
+    for (const Backend &backend : backends) {
+        if (!backend.supported) {
+            std::printf("%-7s skipped, not supported by this CPU\n", backend.name);
+            continue;
+        }
+        for (const MathCase &test : MATH_CASES) {
+            const double error = sweep(backend.evaluator, test);
+            const bool passed = error <= test.maxError;
+            failures += passed ? 0 : 1;
+            std::printf("%-7s %-20s [%7.2f, %7.2f]  max %s error %.3g (bound %.3g)  %s\n", backend.name, test.name,
+                        test.low, test.high, test.relative ? "rel" : "abs", error, test.maxError,
+                        passed ? "ok" : "FAILED");
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,37 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// MathTests.h - The SimdMath functions under test, evaluated with one backend's vectors. Each instruction set's
+// translation unit instantiates evaluate() with its own flags, as the voice kernels do; the reference values and
+// the comparison stay in MathTests.cpp, built for the baseline.
+#pragma once
+
+#include "SimdMath.h"
+
+enum MathFunction { MathSin, MathCos, MathExp2, MathExp, MathTan, MathTanh, MathSemitonesToRatio };
+
+// y[i] = function(x[i]) for a count that is a multiple of the widest vector
+template <typename V>
+void evaluate(MathFunction function, const float *x, float *y, int count) {
+    for (int i = 0; i < count; i += V::width) {
+        const V v = V::load(x + i);
+        V r = v;
+        switch (function) {
+        case MathSin: r = simdmath::sin_ps(v); break;
+        case MathCos: r = simdmath::cos_ps(v); break;
+        case MathExp2: r = simdmath::exp2_ps(v); break;
+        case MathExp: r = simdmath::exp_ps(v); break;
+        case MathTan: r = simdmath::tan_ps(v); break;
+        case MathTanh: r = simdmath::tanh_ps(v); break;
+        case MathSemitonesToRatio: r = simdmath::semitonesToRatio_ps(v); break;
+        }
+        r.store(y + i);
+    }
+}
+
+using MathEvaluator = void (*)(MathFunction function, const float *x, float *y, int count);
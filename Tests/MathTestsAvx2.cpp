@@ -0,0 +1,16 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// MathTestsAvx2.cpp - SimdMath evaluated with AVX2 and FMA, eight lanes. Built with -mavx2 -mfma.
+
+#include "MathTests.h"
+
+#if defined(__AVX2__) && defined(__FMA__)
+extern const MathEvaluator avx2Evaluator;
+const MathEvaluator avx2Evaluator = evaluate<simd::Vec<simd::Avx2>>;
+#endif
@@ -0,0 +1,16 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// MathTestsAvx512.cpp - SimdMath evaluated with AVX-512F, sixteen lanes. Built with -mavx512f.
+
+#include "MathTests.h"
+
+#if defined(__AVX512F__)
+extern const MathEvaluator avx512Evaluator;
+const MathEvaluator avx512Evaluator = evaluate<simd::Vec<simd::Avx512>>;
+#endif
@@ -0,0 +1,95 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// ProcessorTests.cpp - simdsynth-processortests: drives SimdSynthAudioProcessor as a host would, with the message
+// loop run between blocks, and checks that the engine ends up with the parameters the plugin shows. Exits
+// non-zero if any check fails.
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+static constexpr double SAMPLE_RATE = 48000.0;
+static constexpr int BLOCK = 512;
+
+static int failures = 0;
+
+static void check(bool condition, const juce::String &what) {
+    std::printf("  %-64s %s\n", what.toRawUTF8(), condition ? "ok" : "FAILED");
+    failures += condition ? 0 : 1;
+}
+
+static bool nearlyEqual(float a, float b) { return std::abs(a - b) <= 1.0e-4f * std::max(1.0f, std::abs(b)); }
+
+// Set a parameter in plain units, as host automation does
+static void automate(SimdSynthAudioProcessor &processor, int index, float value) {
+    juce::AudioProcessorValueTreeState &parameters = processor.getParameters();
+    if (auto *param = dynamic_cast<juce::RangedAudioParameter *>(parameters.getParameter(PARAMETERS[index].id)))
+        param->setValueNotifyingHost(param->convertTo0to1(value));
+}
+
+static void runMessageLoop() { juce::MessageManager::getInstance()->runDispatchLoopUntil(50); }
+
+// A MIDI program change, with a parameter automated in the same block, and another before the message thread has
+// caught up. The preset must survive the snapshots the automation publishes, and the automated parameter the
+// preset leaves alone must keep its value.
+static void programChangeWithAutomation(bool automateAfter) {
+    std::printf("program change, automation %s it\n", automateAfter ? "after" : "in the same block as");
+    const int program = 1;
+    const PresetLibrary::Preset &preset = PresetManager::getFactoryPreset(program);
+    const juce::String name = PresetManager::getFactoryPresetName(program);
+    if (PresetManager::getPresetDirectory().getChildFile(name + ".json").existsAsFile()) {
+        std::printf("  skipped, a preset file replaces the factory preset %s\n", name.toRawUTF8());
+        return;
+    }
+    check((preset.fields & (1u << ParamCutoff)) != 0 && (preset.fields & (1u << ParamFilterMix)) == 0,
+          "the preset sets the cutoff and leaves the filter mix alone");
+
+    SimdSynthAudioProcessor processor;
+    processor.waitForPresets();
+    processor.setRateAndBufferSizeDetails(SAMPLE_RATE, BLOCK);
+    processor.prepareToPlay(SAMPLE_RATE, BLOCK);
+    runMessageLoop();
+
+    juce::AudioBuffer<float> buffer(2, BLOCK);
+    juce::MidiBuffer midi;
+    midi.addEvent(juce::MidiMessage::programChange(1, program), 0);
+    const float cutoff = preset.values[static_cast<size_t>(ParamCutoff)] * 0.5f;
+    if (!automateAfter) automate(processor, ParamCutoff, cutoff);
+    automate(processor, ParamFilterMix, 0.25f);
+    processor.processBlock(buffer, midi);
+    if (automateAfter) automate(processor, ParamCutoff, cutoff);
+    midi.clear();
+    processor.processBlock(buffer, midi);
+
+    const SynthParams &engine = processor.getEngine().getParameters();
+    check(nearlyEqual(getParameterValue(engine, ParamCutoff), preset.values[static_cast<size_t>(ParamCutoff)]),
+          "before the message thread runs, the engine has the preset's cutoff");
+
+    runMessageLoop();
+    processor.processBlock(buffer, midi);
+    bool presetKept = true;
+    for (int i = 0; i < NUM_PARAMETERS; ++i) {
+        const float value = preset.values[static_cast<size_t>(i)];
+        if (preset.fields & (1u << i)) presetKept &= nearlyEqual(getParameterValue(engine, i), value);
+    }
+    check(presetKept, "afterwards, the engine has every value the preset sets");
+    check(nearlyEqual(getParameterValue(engine, ParamFilterMix), 0.25f), "and the automated filter mix");
+    check(processor.getCurrentProgram() == program, "and the plugin shows the program");
+    processor.releaseResources();
+}
+
+int main() {
+    juce::ScopedJuceInitialiser_GUI juceInit; // Message manager for the parameters and the async updates
+    programChangeWithAutomation(false);
+    programChangeWithAutomation(true);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,35 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// WavetableTests.cpp - simdsynth-wavetabletests: rebuilds every generated set of mips with the runtime code and
+// checks that it matches the compiled-in copy bit for bit, so an instance sounds the same whether its host rate
+// was generated or not. Exits non-zero on any difference.
+
+#include "WavetableData.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+int main() {
+    int failures = 0;
+    std::vector<float> built(static_cast<size_t>(NUM_HARMONIC_TABLES * WAVETABLE_SIZE));
+    for (int i = 0; i < NUM_GENERATED_WAVETABLES; ++i) {
+        const GeneratedWavetables &generated = GENERATED_WAVETABLES[i];
+        Wavetables::buildHarmonicTables(generated.sampleRate, built.data());
+
+        int differences = 0;
+        for (size_t j = 0; j < built.size(); ++j) {
+            differences += std::memcmp(&built[j], &generated.tables[j], sizeof(float)) != 0 ? 1 : 0;
+        }
+        failures += differences > 0 ? 1 : 0;
+        std::printf("%.0f Hz: %d of %zu samples differ  %s\n", generated.sampleRate, differences, built.size(),
+                    differences == 0 ? "ok" : "FAILED");
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,183 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// RenderMain.cpp - simdsynth-render: renders a Standard MIDI File through the plugin's processBlock, offline,
+// and writes the result as a WAV file.
+//
+//   simdsynth-render --midi song.mid --out song.wav [--preset patch.json | --program Name] [--rate 48000]
+//                    [--block 512] [--bits 24] [--tail 2]
+//   simdsynth-render --export-presets
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+static int fail(const juce::String &message) {
+    std::fprintf(stderr, "simdsynth-render: %s\n", message.toRawUTF8());
+    return 1;
+}
+
+static void printUsage() {
+    std::printf("usage: simdsynth-render --midi <file.mid> --out <file.wav>\n"
+                "                        [--preset <file.json> | --program <name>] [--rate <Hz>] [--block <samples>]\n"
+                "                        [--bits 16|24|32] [--tail <seconds>]\n"
+                "       simdsynth-render --export-presets   write the factory presets to the preset directory as JSON\n");
+}
+
+static juce::String optionValue(const juce::ArgumentList &args, const char *option, const char *fallback) {
+    return args.containsOption(option) ? args.getValueForOption(option) : juce::String(fallback);
+}
+
+// Every track of the file merged into one sequence, timestamps in seconds
+static bool readMidiFile(const juce::File &file, juce::MidiMessageSequence &events) {
+    juce::FileInputStream stream(file);
+    juce::MidiFile midi;
+    if (!stream.openedOk() || !midi.readFrom(stream)) return false;
+    midi.convertTimestampTicksToSeconds();
+    for (int track = 0; track < midi.getNumTracks(); ++track) {
+        events.addSequence(*midi.getTrack(track), 0.0);
+    }
+    return true;
+}
+
+static bool writeWavFile(const juce::File &file, const juce::AudioBuffer<float> &audio, int startSample,
+                         int numSamples, double sampleRate, int bitsPerSample) {
+    file.deleteFile();
+    std::unique_ptr<juce::OutputStream> stream = file.createOutputStream();
+    if (stream == nullptr) return false;
+
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(
+        stream.get(), sampleRate, static_cast<unsigned int>(audio.getNumChannels()), bitsPerSample, {}, 0));
+    if (writer == nullptr) return false;
+    stream.release(); // Owned by the writer now
+    return writer->writeFromAudioSampleBuffer(audio, startSample, numSamples);
+}
+
+int main(int argc, char *argv[]) {
+    juce::ScopedJuceInitialiser_GUI juceInit; // Message manager for the processor's parameters and updaters
+    juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--export-presets")) {
+        PresetManager::writeFactoryPresets();
+        std::printf("factory presets in %s\n", PresetManager::getPresetDirectory().getFullPathName().toRawUTF8());
+        return 0;
+    }
+
+    if (args.containsOption("--help|-h") || !args.containsOption("--midi") || !args.containsOption("--out")) {
+        printUsage();
+        return args.containsOption("--help|-h") ? 0 : 1;
+    }
+
+    const juce::File midiFile = args.getFileForOption("--midi");
+    const juce::File outFile = args.getFileForOption("--out");
+    const double sampleRate = optionValue(args, "--rate", "48000").getDoubleValue();
+    const int blockSize = optionValue(args, "--block", "512").getIntValue();
+    const int bitsPerSample = optionValue(args, "--bits", "24").getIntValue();
+    const double tailSeconds = std::max(0.0, optionValue(args, "--tail", "2").getDoubleValue());
+
+    if (sampleRate < 8000.0 || sampleRate > 384000.0) return fail("sample rate out of range");
+    if (blockSize < 1 || blockSize > 8192) return fail("block size must be between 1 and 8192");
+    if (bitsPerSample != 16 && bitsPerSample != 24 && bitsPerSample != 32) return fail("bits must be 16, 24 or 32");
+
+    juce::MidiMessageSequence events;
+    if (!readMidiFile(midiFile, events)) return fail("cannot read MIDI file " + midiFile.getFullPathName());
+
+    SimdSynthAudioProcessor processor;
+    processor.waitForPresets(); // --program and program changes in the file pick presets from the bank
+    if (args.containsOption("--preset")) {
+        const juce::File presetFile = args.getFileForOption("--preset");
+        if (!processor.loadPresetFile(presetFile)) return fail("cannot load preset " + presetFile.getFullPathName());
+    } else if (args.containsOption("--program")) {
+        const juce::String name = args.getValueForOption("--program");
+        const int program = processor.getPresetNames().indexOf(name);
+        if (program < 0) return fail("no preset named " + name);
+        processor.setCurrentProgram(program);
+    }
+
+    // Prepared after the preset so the oversampling factor matches the patch
+    processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+    processor.prepareToPlay(sampleRate, blockSize);
+
+    // Render the oversampler's latency on top of the song and drop it from the start of the file
+    const int latency = processor.getLatencySamples();
+    const int songSamples = static_cast<int>(std::ceil((events.getEndTime() + tailSeconds) * sampleRate));
+    const int totalSamples = songSamples + latency;
+    if (totalSamples == 0) return fail("nothing to render: the MIDI file is empty and --tail is 0");
+
+    juce::AudioBuffer<float> output(2, totalSamples);
+    juce::MidiBuffer midiBlock;
+    std::vector<double> blockMicros;
+    blockMicros.reserve(static_cast<size_t>(totalSamples / blockSize + 1));
+    int nextEvent = 0;
+    int peakVoices = 0;
+
+    for (int start = 0; start < totalSamples; start += blockSize) {
+        const int numSamples = std::min(blockSize, totalSamples - start);
+
+        // MIDI events that fall inside this block, at their sample offsets
+        midiBlock.clear();
+        for (; nextEvent < events.getNumEvents(); ++nextEvent) {
+            const juce::MidiMessage &message = events.getEventPointer(nextEvent)->message;
+            const int position = static_cast<int>(message.getTimeStamp() * sampleRate);
+            if (position >= start + numSamples) break;
+            if (!message.isMetaEvent()) midiBlock.addEvent(message, std::max(0, position - start));
+        }
+
+        juce::AudioBuffer<float> block(output.getArrayOfWritePointers(), 2, start, numSamples);
+        const auto blockStart = std::chrono::steady_clock::now();
+        processor.processBlock(block, midiBlock);
+        const auto blockEnd = std::chrono::steady_clock::now();
+
+        blockMicros.push_back(std::chrono::duration<double, std::micro>(blockEnd - blockStart).count());
+        peakVoices = std::max(peakVoices, processor.getEngine().getActiveVoiceCount());
+    }
+    processor.releaseResources();
+
+    if (!writeWavFile(outFile, output, latency, songSamples, sampleRate, bitsPerSample))
+        return fail("cannot write " + outFile.getFullPathName());
+
+    // Report: realtime factor over the whole render and the per-block time distribution
+    double totalMicros = 0.0;
+    for (double micros : blockMicros) totalMicros += micros;
+    const double audioSeconds = totalSamples / sampleRate;
+    const double meanMicros = totalMicros / static_cast<double>(blockMicros.size());
+    const double budgetMicros = 1.0e6 * blockSize / sampleRate;
+    std::vector<double> sorted = blockMicros;
+    std::sort(sorted.begin(), sorted.end());
+    const double p99Micros = sorted[std::min(sorted.size() - 1, static_cast<size_t>(0.99 * sorted.size()))];
+
+    const KernelTable &kernels = processor.getEngine().getKernels();
+    std::printf("output       %s (%.0f Hz, %d-bit)\n", outFile.getFullPathName().toRawUTF8(), sampleRate,
+                bitsPerSample);
+    std::printf("kernels      %s, %d voices per batch, %dx oversampling\n", kernels.name, kernels.width,
+                processor.getEngine().getOversamplingFactor());
+    std::printf("rendered     %.2f s of audio in %.3f s (%.1fx realtime)\n", audioSeconds, totalMicros * 1.0e-6,
+                audioSeconds / (totalMicros * 1.0e-6));
+    std::printf("block time   min %.1f us, mean %.1f us, p99 %.1f us (budget %.1f us per %d samples)\n", sorted.front(),
+                meanMicros, p99Micros, budgetMicros, blockSize);
+    std::printf("peak voices  %d of %d\n", peakVoices, MAX_VOICE_POLYPHONY);
+
+    // Stage timings, in builds with -DSIMDSYNTH_PROFILING=ON
+    ProfileSnapshot profile;
+    if (processor.readProfile(profile) && profile.blocks > 0) {
+        std::printf("stages       us per block, batch stages summed over threads\n");
+        for (int stage = 0; stage < NUM_PROFILE_STAGES; ++stage) {
+            std::printf("  %-16s %9.2f\n", PROFILE_STAGE_NAMES[stage],
+                        1.0e6 * profile.seconds(profile.stageTicks[stage]) / static_cast<double>(profile.blocks));
+        }
+        std::printf("deadline     mean %.1f%%, worst %.1f%% (%.1f us)\n", profile.meanDeadlinePercent(),
+                    profile.worstDeadlinePercent, 1.0e6 * profile.worstBlockSeconds);
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+/*
+ * simdsynth - A playground for experimenting with SIMD-based audio synthesis,
+ *             featuring polyphonic main and sub-oscillators, filters, envelopes,
+ *             and LFOs per voice, with configurable polyphony.
+ *
+ * MIT Licensed, (c) 2025, seclorum
+ */
+
+// WavetableGen.cpp - simdsynth-wavetablegen: writes the base sine cycle and the band-limited mips for the common
+// host rates as C++ arrays, which the build compiles into SimdSynthCore (see WavetableData.h). The tables come
+// from the same code that builds them at runtime for other rates.
+//
+//   simdsynth-wavetablegen <WavetableData.cpp>
+
+#include "Wavetables.h"
+
+#include <cstdio>
+#include <vector>
+
+static constexpr double GENERATED_RATES[] = {44100.0, 48000.0};
+
+// Hexadecimal float literals, so every value compiles back to exactly the same float
+static void writeArray(std::FILE *out, const char *declaration, const float *values, int count) {
+    std::fprintf(out, "%s = {\n", declaration);
+    for (int i = 0; i < count; ++i) {
+        std::fprintf(out, "%s%af,%s", i % 8 == 0 ? "    " : "", static_cast<double>(values[i]),
+                     i % 8 == 7 || i == count - 1 ? "\n" : " ");
+    }
+    std::fprintf(out, "};\n\n");
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        std::fprintf(stderr, "usage: simdsynth-wavetablegen <WavetableData.cpp>\n");
+        return 1;
+    }
+    std::FILE *out = std::fopen(argv[1], "w");
+    if (out == nullptr) {
+        std::fprintf(stderr, "simdsynth-wavetablegen: cannot write %s\n", argv[1]);
+        return 1;
+    }
+
+    std::fprintf(out, "// Generated by simdsynth-wavetablegen (Tools/WavetableGen.cpp); do not edit.\n\n"
+                      "#include \"WavetableData.h\"\n\n");
+    writeArray(out, "alignas(64) const float GENERATED_SINE[WAVETABLE_SIZE]", Wavetables::getSine(), WAVETABLE_SIZE);
+
+    std::vector<float> tables(static_cast<size_t>(NUM_HARMONIC_TABLES * WAVETABLE_SIZE));
+    for (double rate : GENERATED_RATES) {
+        Wavetables::buildHarmonicTables(rate, tables.data());
+        char declaration[128];
+        std::snprintf(declaration, sizeof(declaration),
+                      "alignas(64) static const float TABLES_%d[NUM_HARMONIC_TABLES * WAVETABLE_SIZE]",
+                      static_cast<int>(rate));
+        writeArray(out, declaration, tables.data(), static_cast<int>(tables.size()));
+    }
+
+    std::fprintf(out, "const GeneratedWavetables GENERATED_WAVETABLES[] = {\n");
+    for (double rate : GENERATED_RATES) std::fprintf(out, "    {%.1f, TABLES_%d},\n", rate, static_cast<int>(rate));
+    std::fprintf(out, "};\n\nconst int NUM_GENERATED_WAVETABLES = %d;\n",
+                 static_cast<int>(sizeof(GENERATED_RATES) / sizeof(GENERATED_RATES[0])));
+    return std::fclose(out) == 0 ? 0 : 1;
+}